@@ -0,0 +1,188 @@
+#include "adc_scan.h"
+#include "tick.h"
+
+// ADTIF interrupt vector number, used as the DMA start trigger
+#define DMA_TRIGGER_ADTIF 0x0B
+
+// ADACT value for the TMR2 postscaled output
+#define ADACT_TMR2 0x04
+
+// ADCON2 ADMD values
+#define ADMD_BURST_AVERAGE 0x03
+#define ADMD_LOW_PASS 0x04
+
+// Indexed by scan_index_t
+static const scan_config_t SCAN_CONFIGS[SCAN_CHANNEL_COUNT] = {
+    // channel          mode                    log2_samples
+    { channel_ANB0,     SCAN_BURST_AVERAGE,     4 },
+    { channel_ANB1,     SCAN_BURST_AVERAGE,     4 },
+    // The brake pot is the noisy one
+    { channel_ANB5,     SCAN_LOW_PASS,          3 },
+};
+
+// Written by DMA1, except that the ADC ISR rewrites each low-pass result
+static volatile adc_result_t scan_buffer[SCAN_CHANNEL_COUNT];
+
+// Last complete set, copied out of scan_buffer before the next scan starts
+static volatile adc_result_t latest[SCAN_CHANNEL_COUNT];
+static volatile uint8_t scan_count = 0;
+// tick_get_us() when the last set completed
+static volatile uint32_t latest_us = 0;
+
+// Threshold windows, in each channel's ADFLTR units. ADERR is ADFLTR here
+// (set point 0), and the defaults never trip
+static uint16_t lower_thresholds[SCAN_CHANNEL_COUNT] = { 0 };
+static uint16_t upper_thresholds[SCAN_CHANNEL_COUNT] = { 0x7FFF, 0x7FFF, 0x7FFF };
+
+// One bit per channel; the scanning masks are published with the set
+static uint8_t above_scanning = 0;
+static uint8_t below_scanning = 0;
+static volatile uint8_t above_latest = 0;
+static volatile uint8_t below_latest = 0;
+
+// The ADCC has one accumulator, so each low-pass channel's filter state is
+// parked here while the other channels convert
+static uint24_t filter_state[SCAN_CHANNEL_COUNT];
+
+static volatile uint8_t scan_channel = 0;
+
+static void load_channel(uint8_t index) {
+    const scan_config_t* config = &SCAN_CONFIGS[index];
+    
+    if (config->mode == SCAN_BURST_AVERAGE) {
+        // ADFLTR = sum >> ADCRS, keeping ADC_EXTRA_BITS of the oversampled sum
+        ADRPT = (uint8_t)(1 << config->log2_samples);
+        ADCON2 = (uint8_t)(((config->log2_samples - ADC_EXTRA_BITS) << 4) | ADMD_BURST_AVERAGE);
+        ADCC_ClearAccumulator();
+    } else {
+        // ADCRS sets the filter time constant; threshold check after every conversion
+        ADRPT = 1;
+        ADCON2 = (uint8_t)((config->log2_samples << 4) | ADMD_LOW_PASS);
+        ADACCU = (uint8_t)(filter_state[index] >> 16);
+        ADACCH = (uint8_t)(filter_state[index] >> 8);
+        ADACCL = (uint8_t)filter_state[index];
+    }
+    
+    ADCC_SetLowerThreshold(lower_thresholds[index]);
+    ADCC_SetUpperThreshold(upper_thresholds[index]);
+    ADPCH = config->channel;
+}
+
+// The first channel is started by TMR2, so it is only loaded here
+static void arm_scan(void) {
+    scan_channel = 0;
+    above_scanning = 0;
+    below_scanning = 0;
+    DMA1_StartTransferWithTrigger();
+    load_channel(0);
+}
+
+static void channel_done_isr(void) {
+    const scan_config_t* config = &SCAN_CONFIGS[scan_channel];
+    
+    // DMA1 has already taken ADFLTR, and the ADCC has compared it
+    if (ADCC_HasErrorCrossedUpperThreshold()) {
+        above_scanning |= (uint8_t)(1 << scan_channel);
+    }
+    if (ADCC_HasErrorCrossedLowerThreshold()) {
+        below_scanning |= (uint8_t)(1 << scan_channel);
+    }
+    if (config->mode == SCAN_LOW_PASS) {
+        // ADFLTR is ADACC >> ADCRS, a plain 12-bit value; the accumulator
+        // has the filter's extra bits too, so take the result from there
+        filter_state[scan_channel] = ADCC_GetAccumulatorValue();
+        scan_buffer[scan_channel] = (adc_result_t)(filter_state[scan_channel] >> (config->log2_samples - ADC_EXTRA_BITS));
+    }
+    
+    scan_channel++;
+    if (scan_channel < SCAN_CHANNEL_COUNT) {
+        load_channel(scan_channel);
+        ADCON0bits.ADGO = 1;
+    }
+}
+
+// The last channel's ADTIF is always set before this DCNTIF, and the
+// interrupt manager checks ADTIF first, so channel_done_isr() has finished
+// with the scan by the time it is re-armed here
+static void scan_done_isr(void) {
+    for (uint8_t i = 0; i < SCAN_CHANNEL_COUNT; i++) {
+        latest[i] = scan_buffer[i];
+    }
+    above_latest = above_scanning;
+    below_latest = below_scanning;
+    latest_us = tick_get_us_isr();
+    scan_count++;
+    arm_scan();
+}
+
+void adc_scan_init(void) {
+    // Seed each low-pass filter with a plain conversion so it does not ramp
+    // up from zero (which would also spoil the LV calibration)
+    for (uint8_t i = 0; i < SCAN_CHANNEL_COUNT; i++) {
+        if (SCAN_CONFIGS[i].mode == SCAN_LOW_PASS) {
+            filter_state[i] = (uint24_t)ADCC_GetSingleConversion(SCAN_CONFIGS[i].channel) << SCAN_CONFIGS[i].log2_samples;
+        }
+    }
+    // Those conversions raised ADTIF too; it must not reach the scan ISR
+    PIR1bits.ADTIF = 0;
+    
+    // Each ADTIF moves both ADFLTR bytes, and the DMA stops after filling
+    // a buffer
+    DMA1_SetSourceAddress((uint24_t)&ADFLTRL);
+    DMA1_SetSourceSize(sizeof(adc_result_t));
+    DMA1_SetDestinationAddress((uint16_t)scan_buffer);
+    DMA1_SetDestinationSize(sizeof(scan_buffer));
+    DMA1_SetStartTrigger(DMA_TRIGGER_ADTIF);
+    DMA1_SetDMADestCountInterruptHandler(scan_done_isr);
+    
+    ADCC_SetADTIInterruptHandler(channel_done_isr);
+    ADCC_DisableContinuousConversion();
+    ADCC_DefineSetPoint(0);
+    
+    // Restart the period so the first trigger cannot land mid-setup
+    TMR2_Stop();
+    arm_scan();
+    T2TMR = 0;
+    ADACT = ADACT_TMR2;
+    TMR2_Start();
+}
+
+uint8_t adc_scan_read(adc_result_t* results, uint32_t* time_us) {
+    uint8_t count;
+    
+    // Retry if a scan completed mid-copy
+    do {
+        count = scan_count;
+        for (uint8_t i = 0; i < SCAN_CHANNEL_COUNT; i++) {
+            results[i] = latest[i];
+        }
+        *time_us = latest_us;
+    } while (count != scan_count);
+    
+    return count;
+}
+
+void adc_scan_set_thresholds(scan_index_t index, adc_result_t lower, adc_result_t upper) {
+    // Low-pass channels are compared as plain 12-bit in ADFLTR. The result
+    // is that value with ADC_EXTRA_BITS more below it, so comparing the
+    // truncated thresholds gives the same answer to within one 12-bit count
+    if (SCAN_CONFIGS[index].mode == SCAN_LOW_PASS) {
+        lower >>= ADC_EXTRA_BITS;
+        upper >>= ADC_EXTRA_BITS;
+    }
+    
+    // load_channel() reads these from the ADC ISR
+    bool enabled = PIE1bits.ADTIE;
+    PIE1bits.ADTIE = 0;
+    lower_thresholds[index] = lower;
+    upper_thresholds[index] = upper;
+    PIE1bits.ADTIE = enabled;
+}
+
+bool adc_scan_above(scan_index_t index) {
+    return (above_latest >> index) & 1;
+}
+
+bool adc_scan_below(scan_index_t index) {
+    return (below_latest >> index) & 1;
+}
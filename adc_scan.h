@@ -0,0 +1,74 @@
+#ifndef ADC_SCAN_H
+#define ADC_SCAN_H
+
+#include "mcc_generated_files/mcc.h"
+
+// Timer-triggered, DMA-backed ADC scan with hardware oversampling
+// TMR2 auto-triggers (ADACT) the first conversion of every scan, so sets are
+// taken at exactly ADC_SCAN_PERIOD_US whatever the CPU is doing. Each channel
+// is filtered by the ADCC itself (burst average or low-pass). When a
+// channel's computation finishes, the threshold interrupt triggers DMA1,
+// which copies ADFLTR straight into a RAM buffer. The ADC ISR then only
+// loads the next channel's filter settings and starts its conversion.
+// After the last channel, the DMA destination count interrupt publishes the
+// set and re-arms the first channel for the next trigger. Consumers read
+// the latest complete set, never a half-written one.
+// The ADCC also compares every filtered result against that channel's
+// thresholds, so limit checks cost the CPU nothing but latching two
+// ADSTAT bits in the ISR. A low-pass channel's ADFLTR drops the filter's
+// extra bits, so its thresholds are compared at 12 bits, and the ISR takes
+// the result it publishes from the accumulator instead.
+
+// Set by the TMR2 period (500 kHz / 4 / 250)
+#define ADC_SCAN_PERIOD_US 2000
+
+// Index into the sample buffer; add a row here and in SCAN_CONFIGS for
+// each new channel
+typedef enum {
+    SCAN_THROTTLE1,
+    SCAN_THROTTLE2,
+    SCAN_BRAKE,
+    SCAN_CHANNEL_COUNT
+} scan_index_t;
+
+typedef enum {
+    // ADRPT back-to-back conversions per scan, averaged. Oversampling by
+    // 4^n adds n real bits, which are kept in the result
+    SCAN_BURST_AVERAGE,
+    // One conversion per scan into a first-order low-pass filter whose
+    // time constant is 2^log2_samples scans, at least 2^ADC_EXTRA_BITS. The
+    // filter's gain of 2^log2_samples gives the extra bits
+    SCAN_LOW_PASS
+} scan_mode_t;
+
+typedef struct {
+    adcc_channel_t channel;
+    scan_mode_t mode;
+    uint8_t log2_samples;
+} scan_config_t;
+
+// The converter is 12 bits; results are scaled to 12 + ADC_EXTRA_BITS
+#define ADC_EXTRA_BITS 2
+#define ADC_RESULT_BITS (12 + ADC_EXTRA_BITS)
+// Highest possible reading: 12-bit full scale, scaled up. The extra bits
+// come from averaging, so they never all read 1
+#define ADC_RESULT_MAX (4095U << ADC_EXTRA_BITS)
+
+// Arms the scan; sampling then runs on its own
+void adc_scan_init(void);
+
+// Copies the latest complete set, scaled to ADC_RESULT_BITS, into results
+// (indexed by scan_index_t) and returns its scan count. time_us gets the
+// tick_get_us() time the set completed, for end-to-end latencies
+uint8_t adc_scan_read(adc_result_t* results, uint32_t* time_us);
+
+// Sets the window a channel is checked against, scaled to ADC_RESULT_BITS
+// (low-pass channels are checked at 12 bits). Takes effect from the next scan
+void adc_scan_set_thresholds(scan_index_t index, adc_result_t lower, adc_result_t upper);
+
+// Whether the channel was above its upper / below its lower threshold in
+// the latest complete set
+bool adc_scan_above(scan_index_t index);
+bool adc_scan_below(scan_index_t index);
+
+#endif // ADC_SCAN_H
@@ -0,0 +1,177 @@
+#ifndef CAN_MESSAGES_H
+#define CAN_MESSAGES_H
+
+#include "mcc_generated_files/ecan.h"
+
+// Generated by tools/dbc_codegen.py from can.dbc; edit that instead
+// Signals are raw values as on the wire, scaled as commented
+
+
+// VCU_Pedals, sent by VCU
+// Latest pedal values, every 10 ms
+#define CAN_ID_VCU_PEDALS 0x100
+#define CAN_DLC_VCU_PEDALS 6
+
+typedef struct {
+    uint16_t throttle1;  // ADC counts
+    uint16_t throttle2;  // ADC counts
+    uint16_t brake;      // ADC counts
+} vcu_pedals_t;
+
+static inline void vcu_pedals_pack(uCAN_MSG* msg, const vcu_pedals_t* signals) {
+    msg->frame.idType = dSTANDARD_CAN_MSG_ID_2_0B;
+    msg->frame.id = CAN_ID_VCU_PEDALS;
+    msg->frame.dlc = CAN_DLC_VCU_PEDALS;
+    msg->frame.data0 = (uint8_t)signals->throttle1;
+    msg->frame.data1 = (uint8_t)((uint16_t)signals->throttle1 >> 8);
+    msg->frame.data2 = (uint8_t)signals->throttle2;
+    msg->frame.data3 = (uint8_t)((uint16_t)signals->throttle2 >> 8);
+    msg->frame.data4 = (uint8_t)signals->brake;
+    msg->frame.data5 = (uint8_t)((uint16_t)signals->brake >> 8);
+    msg->frame.data6 = 0;
+    msg->frame.data7 = 0;
+}
+
+static inline void vcu_pedals_unpack(const uCAN_MSG* msg, vcu_pedals_t* signals) {
+    signals->throttle1 = (uint16_t)((uint16_t)msg->frame.data0 | ((uint16_t)msg->frame.data1 << 8));
+    signals->throttle2 = (uint16_t)((uint16_t)msg->frame.data2 | ((uint16_t)msg->frame.data3 << 8));
+    signals->brake = (uint16_t)((uint16_t)msg->frame.data4 | ((uint16_t)msg->frame.data5 << 8));
+}
+
+
+// VCU_State, sent by VCU
+// FSM state, every 10 ms
+#define CAN_ID_VCU_STATE 0x101
+#define CAN_DLC_VCU_STATE 4
+
+typedef struct {
+    uint8_t state;            // state_t
+    uint8_t error;            // error_t
+    uint16_t torque_request;  // Per mille of TORQUE_MAX
+} vcu_state_t;
+
+static inline void vcu_state_pack(uCAN_MSG* msg, const vcu_state_t* signals) {
+    msg->frame.idType = dSTANDARD_CAN_MSG_ID_2_0B;
+    msg->frame.id = CAN_ID_VCU_STATE;
+    msg->frame.dlc = CAN_DLC_VCU_STATE;
+    msg->frame.data0 = (uint8_t)signals->state;
+    msg->frame.data1 = (uint8_t)signals->error;
+    msg->frame.data2 = (uint8_t)signals->torque_request;
+    msg->frame.data3 = (uint8_t)((uint16_t)signals->torque_request >> 8);
+    msg->frame.data4 = 0;
+    msg->frame.data5 = 0;
+    msg->frame.data6 = 0;
+    msg->frame.data7 = 0;
+}
+
+static inline void vcu_state_unpack(const uCAN_MSG* msg, vcu_state_t* signals) {
+    signals->state = (uint8_t)msg->frame.data0;
+    signals->error = (uint8_t)msg->frame.data1;
+    signals->torque_request = (uint16_t)((uint16_t)msg->frame.data2 | ((uint16_t)msg->frame.data3 << 8));
+}
+
+
+// Inverter_Command, sent by VCU
+// Cascadia Motion M192 command message, every 2 ms
+#define CAN_ID_INVERTER_COMMAND 0x0C0
+#define CAN_DLC_INVERTER_COMMAND 8
+
+typedef struct {
+    int16_t torque_command;        // 0.1 Nm
+    int16_t speed_command;         // Unused in torque mode, rpm
+    uint8_t direction_command;
+    uint8_t inverter_enable;
+    uint8_t inverter_discharge;
+    uint8_t speed_mode_enable;
+    int16_t torque_limit_command;  // 0 keeps the inverter's own limit, 0.1 Nm
+} inverter_command_t;
+
+static inline void inverter_command_pack(uCAN_MSG* msg, const inverter_command_t* signals) {
+    msg->frame.idType = dSTANDARD_CAN_MSG_ID_2_0B;
+    msg->frame.id = CAN_ID_INVERTER_COMMAND;
+    msg->frame.dlc = CAN_DLC_INVERTER_COMMAND;
+    msg->frame.data0 = (uint8_t)signals->torque_command;
+    msg->frame.data1 = (uint8_t)((uint16_t)signals->torque_command >> 8);
+    msg->frame.data2 = (uint8_t)signals->speed_command;
+    msg->frame.data3 = (uint8_t)((uint16_t)signals->speed_command >> 8);
+    msg->frame.data4 = (uint8_t)((uint8_t)signals->direction_command & 0x1);
+    msg->frame.data5 = (uint8_t)((uint8_t)signals->inverter_enable & 0x1) | (uint8_t)(((uint8_t)signals->inverter_discharge & 0x1) << 1) | (uint8_t)(((uint8_t)signals->speed_mode_enable & 0x1) << 2);
+    msg->frame.data6 = (uint8_t)signals->torque_limit_command;
+    msg->frame.data7 = (uint8_t)((uint16_t)signals->torque_limit_command >> 8);
+}
+
+static inline void inverter_command_unpack(const uCAN_MSG* msg, inverter_command_t* signals) {
+    signals->torque_command = (int16_t)((uint16_t)msg->frame.data0 | ((uint16_t)msg->frame.data1 << 8));
+    signals->speed_command = (int16_t)((uint16_t)msg->frame.data2 | ((uint16_t)msg->frame.data3 << 8));
+    signals->direction_command = (uint8_t)(msg->frame.data4 & 0x1);
+    signals->inverter_enable = (uint8_t)(msg->frame.data5 & 0x1);
+    signals->inverter_discharge = (uint8_t)((msg->frame.data5 >> 1) & 0x1);
+    signals->speed_mode_enable = (uint8_t)((msg->frame.data5 >> 2) & 0x1);
+    signals->torque_limit_command = (int16_t)((uint16_t)msg->frame.data6 | ((uint16_t)msg->frame.data7 << 8));
+}
+
+
+// Inverter_Voltage, sent by Inverter
+// Cascadia Motion M167 voltage information
+#define CAN_ID_INVERTER_VOLTAGE 0x0A7
+#define CAN_DLC_INVERTER_VOLTAGE 8
+
+typedef struct {
+    int16_t dc_bus_voltage;  // 0.1 V
+    int16_t output_voltage;  // 0.1 V
+} inverter_voltage_t;
+
+static inline void inverter_voltage_pack(uCAN_MSG* msg, const inverter_voltage_t* signals) {
+    msg->frame.idType = dSTANDARD_CAN_MSG_ID_2_0B;
+    msg->frame.id = CAN_ID_INVERTER_VOLTAGE;
+    msg->frame.dlc = CAN_DLC_INVERTER_VOLTAGE;
+    msg->frame.data0 = (uint8_t)signals->dc_bus_voltage;
+    msg->frame.data1 = (uint8_t)((uint16_t)signals->dc_bus_voltage >> 8);
+    msg->frame.data2 = (uint8_t)signals->output_voltage;
+    msg->frame.data3 = (uint8_t)((uint16_t)signals->output_voltage >> 8);
+    msg->frame.data4 = 0;
+    msg->frame.data5 = 0;
+    msg->frame.data6 = 0;
+    msg->frame.data7 = 0;
+}
+
+static inline void inverter_voltage_unpack(const uCAN_MSG* msg, inverter_voltage_t* signals) {
+    signals->dc_bus_voltage = (int16_t)((uint16_t)msg->frame.data0 | ((uint16_t)msg->frame.data1 << 8));
+    signals->output_voltage = (int16_t)((uint16_t)msg->frame.data2 | ((uint16_t)msg->frame.data3 << 8));
+}
+
+
+// Inverter_State, sent by Inverter
+// Cascadia Motion M170 internal states
+#define CAN_ID_INVERTER_STATE 0x0AA
+#define CAN_DLC_INVERTER_STATE 8
+
+typedef struct {
+    uint8_t vsm_state;
+    uint8_t inverter_state;
+    uint8_t inverter_enable_state;
+    uint8_t inverter_enable_lockout;
+} inverter_state_t;
+
+static inline void inverter_state_pack(uCAN_MSG* msg, const inverter_state_t* signals) {
+    msg->frame.idType = dSTANDARD_CAN_MSG_ID_2_0B;
+    msg->frame.id = CAN_ID_INVERTER_STATE;
+    msg->frame.dlc = CAN_DLC_INVERTER_STATE;
+    msg->frame.data0 = (uint8_t)signals->vsm_state;
+    msg->frame.data1 = 0;
+    msg->frame.data2 = (uint8_t)signals->inverter_state;
+    msg->frame.data3 = 0;
+    msg->frame.data4 = 0;
+    msg->frame.data5 = 0;
+    msg->frame.data6 = (uint8_t)((uint8_t)signals->inverter_enable_state & 0x1) | (uint8_t)((uint8_t)signals->inverter_enable_lockout << 7);
+    msg->frame.data7 = 0;
+}
+
+static inline void inverter_state_unpack(const uCAN_MSG* msg, inverter_state_t* signals) {
+    signals->vsm_state = (uint8_t)msg->frame.data0;
+    signals->inverter_state = (uint8_t)msg->frame.data2;
+    signals->inverter_enable_state = (uint8_t)(msg->frame.data6 & 0x1);
+    signals->inverter_enable_lockout = (uint8_t)(msg->frame.data6 >> 7);
+}
+
+#endif // CAN_MESSAGES_H
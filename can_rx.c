@@ -0,0 +1,71 @@
+#include "can_rx.h"
+#include "tick.h"
+
+static volatile inverter_status_t inverter;
+// No state message yet, so the timestamp means nothing
+static volatile bool state_seen = false;
+
+static void rx_isr(void) {
+    uCAN_MSG msg;
+    inverter_voltage_t voltage;
+    inverter_state_t state;
+    
+    while (CAN_receive(&msg)) {
+        // Standard IDs only get through the filters
+        switch (msg.frame.id) {
+            case CAN_ID_INVERTER_VOLTAGE:
+                inverter_voltage_unpack(&msg, &voltage);
+                inverter.dc_bus_dv = voltage.dc_bus_voltage;
+                break;
+            case CAN_ID_INVERTER_STATE:
+                inverter_state_unpack(&msg, &state);
+                inverter.vsm_state = state.vsm_state;
+                inverter.state_ms = tick_get_ms_isr();
+                state_seen = true;
+                break;
+        }
+        inverter.frames++;
+    }
+    
+    if (CAN_hasRXOverflowed()) {
+        inverter.overflows++;
+    }
+}
+
+static void mask_rx_interrupts(bool masked) {
+    PIE5bits.RXB0IE = !masked;
+    PIE5bits.RXB1IE = !masked;
+}
+
+void can_rx_init(void) {
+    inverter.dc_bus_dv = 0;
+    inverter.vsm_state = 0;
+    inverter.state_ms = 0;
+    inverter.frames = 0;
+    inverter.overflows = 0;
+    state_seen = false;
+    ECAN_SetRXBnInterruptHandler(rx_isr);
+}
+
+void can_rx_get_inverter(inverter_status_t* status) {
+    mask_rx_interrupts(true);
+    *status = inverter;
+    mask_rx_interrupts(false);
+}
+
+bool can_rx_precharged(void) {
+    inverter_status_t status;
+    
+    mask_rx_interrupts(true);
+    bool seen = state_seen;
+    status = inverter;
+    mask_rx_interrupts(false);
+    
+    // In ms, so a controller silent for longer than the us counter's
+    // ~71 minute wrap still reads as stale
+    if (!seen || tick_get_ms() - status.state_ms >= INVERTER_TIMEOUT_MS) {
+        return false;
+    }
+    return status.vsm_state >= INVERTER_VSM_PRECHARGE_COMPLETE
+        && status.vsm_state <= INVERTER_VSM_MOTOR_RUNNING;
+}
@@ -0,0 +1,44 @@
+#ifndef CAN_RX_H
+#define CAN_RX_H
+
+#include "mcc_generated_files/mcc.h"
+#include "can_messages.h"
+
+// Interrupt-driven CAN receive
+// The ECAN acceptance filters (see ECAN_Initialize()) only pass the motor
+// controller's messages below, so every RX interrupt is one we need. The
+// ISR decodes them straight into a snapshot, which the FSM reads; precharge
+// completion is seen as soon as its frame arrives instead of on a poll.
+
+// Motor controller messages are Cascadia Motion PM/RM defaults, laid out
+// in can.dbc
+
+// VSM states from precharge complete up to motor running mean the DC bus
+// is charged; the fault state and anything below do not
+#define INVERTER_VSM_PRECHARGE_COMPLETE 3
+#define INVERTER_VSM_MOTOR_RUNNING 6
+
+// The motor controller broadcasts its state every 100 ms by default
+#define INVERTER_BROADCAST_MS 100
+// A snapshot older than this is not trusted. Three periods, so one late or
+// lost frame (or a broadcast landing just after the check) is tolerated
+#define INVERTER_TIMEOUT_MS (3 * INVERTER_BROADCAST_MS)
+
+typedef struct {
+    int16_t dc_bus_dv;          // 0.1 V
+    uint8_t vsm_state;
+    uint32_t state_ms;          // tick_get_ms() of the last state message
+    uint16_t frames;            // messages received
+    uint16_t overflows;         // times a message was lost to full RX buffers
+} inverter_status_t;
+
+void can_rx_init(void);
+
+// Copies the snapshot with the RX interrupts held off
+void can_rx_get_inverter(inverter_status_t* status);
+
+// True if a state message arrived in the last INVERTER_TIMEOUT_MS and says
+// the DC bus is precharged
+bool can_rx_precharged(void);
+
+#endif // CAN_RX_H
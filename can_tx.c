@@ -0,0 +1,156 @@
+#include "can_tx.h"
+#include "tick.h"
+
+#include <string.h>
+
+// Highest TXPRI left for these buffers; TXB0 uses the top one
+#define CAN_TX_PRIORITY_MAX 2
+
+typedef struct {
+    uint32_t key;           // arbitration order, lower wins
+    uCAN_MSG msg;
+    uint32_t sample_us;
+    bool waiting;           // holds data not yet loaded into a buffer
+} can_tx_slot_t;
+
+volatile can_tx_stats_t can_tx_stats;
+
+// Slots claimed so far, sorted by key. An ID keeps its slot once claimed
+static can_tx_slot_t slots[CAN_TX_SLOT_COUNT];
+static uint8_t slot_count = 0;
+
+// Key, sample time and TXPRI of the message in each hardware buffer
+// (TXB0 is not ours)
+static uint32_t buffer_key[ECAN_TX_BUFFER_COUNT];
+static uint32_t buffer_sample_us[ECAN_TX_BUFFER_COUNT];
+static uint8_t buffer_priority[ECAN_TX_BUFFER_COUNT];
+
+// Sorts like bus arbitration: by the 11-bit base ID first, then by the
+// 18-bit extension, with a standard frame beating an extended one with the
+// same base ID
+static uint32_t arbitration_key(const uCAN_MSG* msg) {
+    if (msg->frame.idType == dEXTENDED_CAN_MSG_ID_2_0B) {
+        return (msg->frame.id << 1) | 1;
+    }
+    return (uint32_t)msg->frame.id << 19;
+}
+
+// A TXPRI that sends this key before or after whatever the other buffers
+// are still holding. With only two buffers that is one neighbour, so the
+// order holds except when the neighbour is already at the end of the range
+static uint8_t buffer_priority_for(uint8_t buffer, uint32_t key) {
+    uint8_t priority = 1;
+    
+    for (uint8_t other = CAN_TX_FIRST_BUFFER; other < ECAN_TX_BUFFER_COUNT; other++) {
+        if (other == buffer || !CAN_isTXBufferPending(other)) {
+            continue;
+        }
+        if (key < buffer_key[other]) {
+            priority = buffer_priority[other] < CAN_TX_PRIORITY_MAX ? buffer_priority[other] + 1 : CAN_TX_PRIORITY_MAX;
+        }
+        else {
+            priority = buffer_priority[other] > 0 ? buffer_priority[other] - 1 : 0;
+        }
+    }
+    return priority;
+}
+
+// Moves the highest-priority waiting slot into the given buffer if it is
+// free. Runs in the TX ISR, or with the TX interrupts masked
+static void load_buffer(uint8_t buffer) {
+    uint8_t i;
+    
+    if (CAN_isTXBufferPending(buffer)) {
+        return;
+    }
+    for (i = 0; i < slot_count; i++) {
+        if (slots[i].waiting) {
+            break;
+        }
+    }
+    if (i == slot_count) {
+        return;
+    }
+    
+    can_tx_slot_t* slot = &slots[i];
+    // TXPRI can only change while the buffer is idle
+    uint8_t priority = buffer_priority_for(buffer, slot->key);
+    ECAN_SetTXBnPriority(buffer, priority);
+    if (CAN_transmitBuffer(buffer, &slot->msg)) {
+        buffer_key[buffer] = slot->key;
+        buffer_sample_us[buffer] = slot->sample_us;
+        buffer_priority[buffer] = priority;
+        slot->waiting = false;
+    }
+}
+
+static void tx_done_isr(uint8_t buffer) {
+    uint32_t latency_us = tick_get_us_isr() - buffer_sample_us[buffer];
+    
+    can_tx_stats.sent++;
+    if (latency_us > can_tx_stats.latency_max_us) {
+        can_tx_stats.latency_max_us = latency_us;
+    }
+    
+    load_buffer(buffer);
+}
+
+static void mask_tx_interrupts(bool masked) {
+    PIE5bits.TXB1IE = !masked;
+    PIE5bits.TXB2IE = !masked;
+}
+
+void can_tx_init(void) {
+    slot_count = 0;
+    can_tx_stats.sent = 0;
+    can_tx_stats.replaced = 0;
+    can_tx_stats.dropped = 0;
+    can_tx_stats.latency_max_us = 0;
+    for (uint8_t buffer = CAN_TX_FIRST_BUFFER; buffer < ECAN_TX_BUFFER_COUNT; buffer++) {
+        ECAN_SetTXBnInterruptHandler(buffer, tx_done_isr);
+    }
+}
+
+bool can_tx_queue(const uCAN_MSG* msg, uint32_t sample_us) {
+    uint32_t key = arbitration_key(msg);
+    uint8_t i;
+    
+    mask_tx_interrupts(true);
+    
+    for (i = 0; i < slot_count; i++) {
+        if (slots[i].key >= key) {
+            break;
+        }
+    }
+    if (i == slot_count || slots[i].key != key) {
+        // First frame with this ID; claim a slot in order
+        if (slot_count == CAN_TX_SLOT_COUNT) {
+            can_tx_stats.dropped++;
+            mask_tx_interrupts(false);
+            return false;
+        }
+        memmove(&slots[i + 1], &slots[i], (slot_count - i) * sizeof(slots[0]));
+        slot_count++;
+        slots[i].key = key;
+    }
+    else if (slots[i].waiting) {
+        can_tx_stats.replaced++;
+    }
+    slots[i].msg = *msg;
+    slots[i].sample_us = sample_us;
+    slots[i].waiting = true;
+    
+    // Idle buffers have no interrupt coming to pick the message up
+    for (uint8_t buffer = CAN_TX_FIRST_BUFFER; buffer < ECAN_TX_BUFFER_COUNT; buffer++) {
+        load_buffer(buffer);
+    }
+    
+    mask_tx_interrupts(false);
+    return true;
+}
+
+void can_tx_get_stats(can_tx_stats_t* stats) {
+    mask_tx_interrupts(true);
+    *stats = can_tx_stats;
+    mask_tx_interrupts(false);
+}
@@ -0,0 +1,41 @@
+#ifndef CAN_TX_H
+#define CAN_TX_H
+
+#include "mcc_generated_files/mcc.h"
+
+// Interrupt-driven, latest-value CAN transmit
+// Each message ID gets one slot the first time it is queued. Queuing an ID
+// whose slot is still waiting overwrites it, so a busy bus only ever holds
+// back the newest value of each message, never a growing backlog of stale
+// ones. The slots are kept in bus arbitration order, and the ECAN TX
+// interrupt loads the highest-priority waiting one into whichever of TXB1
+// and TXB2 has finished, so no task waits on the bus; TXB0 is left to the
+// torque command, see torque_cmd.h. Each message carries the tick_get_us()
+// time its data was sampled; the TX interrupt of its buffer, which fires
+// once the frame is on the wire, turns that into the sample-to-wire
+// latency.
+
+// Distinct message IDs that can be sent; more are dropped
+#define CAN_TX_SLOT_COUNT 4
+
+// Hardware buffers from this one up are fed from the slots
+#define CAN_TX_FIRST_BUFFER 1
+
+typedef struct {
+    uint16_t sent;              // frames acknowledged on the bus
+    uint16_t replaced;          // frames overwritten by newer data before they were sent
+    uint16_t dropped;           // frames not queued because every slot has another ID
+    uint32_t latency_max_us;    // sample to end of frame
+} can_tx_stats_t;
+
+extern volatile can_tx_stats_t can_tx_stats;
+
+void can_tx_init(void);
+
+// Returns false, and counts a drop, if the ID has no slot and none is left
+bool can_tx_queue(const uCAN_MSG* msg, uint32_t sample_us);
+
+// Copies the stats with the TX interrupts held off
+void can_tx_get_stats(can_tx_stats_t* stats);
+
+#endif // CAN_TX_H
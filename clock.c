@@ -0,0 +1,89 @@
+#include "clock.h"
+
+typedef struct {
+    uint8_t oscfrq;     // HFINTOSC frequency select
+    uint8_t osccon1;    // NOSC and NDIV
+    uint32_t fosc;
+} clock_config_t;
+
+// Indexed by clock_profile_t
+static const clock_config_t CLOCK_CONFIGS[] = {
+    // OSCFRQ   OSCCON1                 Fosc
+    { 0x03,     0x60 /* HFINTOSC, 1:1 */, 8000000UL },
+    { 0x08,     0x60 /* HFINTOSC, 1:1 */, 64000000UL },
+};
+
+// Matches OSCILLATOR_Initialize()
+static clock_profile_t profile = CLOCK_LOW_POWER;
+
+static void update_dividers(uint32_t fosc) {
+    // BRGS is high speed, so baud = Fosc / (4 * (BRG + 1))
+    uint16_t brg = (uint16_t)((fosc / 4 + UART1_BAUD / 2) / UART1_BAUD - 1);
+    U1BRGH = (uint8_t)(brg >> 8);
+    U1BRGL = (uint8_t)brg;
+    
+    // ADC clock = Fosc / (2 * (ADCLK + 1)), switched from FRC to Fosc so
+    // conversions speed up with the core
+    ADCLK = (uint8_t)(fosc / (2 * ADC_TAD_HZ) - 1);
+    ADCON0bits.ADCS = 0;
+    
+    // TQ = 2 * (BRP + 1) / Fosc; only written in configuration mode
+    ECAN_SetBaudRatePrescaler((uint8_t)(fosc / (2 * CAN_TQ_PER_BIT * CAN_BITRATE) - 1));
+}
+
+void clock_init(void) {
+    ECAN_OP_MODES can_mode = ECAN_GetOperationMode();
+    ECAN_SetOperationMode(ECAN_CONFIGURATION_MODE);
+    update_dividers(CLOCK_CONFIGS[profile].fosc);
+    ECAN_SetOperationMode(can_mode);
+}
+
+void clock_set_profile(clock_profile_t new_profile) {
+    if (new_profile == profile) {
+        return;
+    }
+    
+    // Let the UART finish the byte in flight at the old baud rate. The
+    // transmitter is held so it does not refill the UART meanwhile; it
+    // resumes where it stopped afterwards and the baud rate is the same
+    // after the switch, so queued bytes are unaffected
+    bool tx_sending = UART1_HoldTx();
+    while (!UART1_is_tx_done()) {
+    }
+    
+    // Take CAN off the bus (after the frame in progress) so nothing is sent
+    // with the bit timing half switched. Loaded TX buffers stay pending and
+    // go out once the mode is restored
+    ECAN_OP_MODES can_mode = ECAN_GetOperationMode();
+    ECAN_SetOperationMode(ECAN_CONFIGURATION_MODE);
+    
+    const clock_config_t* config = &CLOCK_CONFIGS[new_profile];
+    
+    // No conversion may run across the ADCLK change. Hold off TMR2's scan
+    // trigger and let the scan in progress finish; the ADC ISR chains its
+    // channels, so check again once it can no longer start one. The next
+    // scan starts on the first trigger after the switch
+    uint8_t adc_trigger = ADACT;
+    ADACT = 0;
+    while (ADCON0bits.ADGO) {
+    }
+    INTERRUPT_GlobalInterruptDisable();
+    while (ADCON0bits.ADGO) {
+    }
+    
+    OSCFRQ = config->oscfrq;
+    OSCCON1 = config->osccon1;
+    while (!OSCCON3bits.ORDY) {
+        // wait for the new oscillator to be ready
+    }
+    update_dividers(config->fosc);
+    ADACT = adc_trigger;
+    profile = new_profile;
+    UART1_ReleaseTx(tx_sending);
+    INTERRUPT_GlobalInterruptEnable();
+    ECAN_SetOperationMode(can_mode);
+}
+
+clock_profile_t clock_get_profile(void) {
+    return profile;
+}
@@ -0,0 +1,40 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "mcc_generated_files/mcc.h"
+
+// Runtime clock profiles
+// Switching profile re-derives every Fosc-dependent divisor (UART1 baud,
+// ADCC conversion clock, ECAN bit timing). TMR0/TMR1 run from the fixed
+// 500 kHz MFINTOSC and delays should use tick_delay_ms(), so neither needs
+// to change.
+
+typedef enum {
+    // 8 MHz, used in LV; the lowest clock that still runs CAN at 500 kbps
+    // (8 TQ of 2 / Fosc each)
+    CLOCK_LOW_POWER,
+    CLOCK_FULL_SPEED,   // 64 MHz, used in DRIVE
+    CLOCK_PROFILE_COUNT
+} clock_profile_t;
+
+// 250000 is exact at both profiles (BRG 7 and 63) if telemetry needs more
+// than the ~960 bytes/s 9600 baud gives
+#ifndef UART1_BAUD
+#define UART1_BAUD 9600
+#endif
+
+// Target ADC conversion clock period (TAD) of 2 us
+#define ADC_TAD_HZ 500000UL
+
+// CAN bit rate, with the bit split into CAN_TQ_PER_BIT time quanta as in
+// ECAN_Initialize()
+#define CAN_BITRATE 500000UL
+#define CAN_TQ_PER_BIT 8
+
+// Derives the divisors for the reset clock
+void clock_init(void);
+
+void clock_set_profile(clock_profile_t profile);
+clock_profile_t clock_get_profile(void);
+
+#endif // CLOCK_H
@@ -0,0 +1,195 @@
+#include "console.h"
+#include "mcc_generated_files/uart1.h"
+#include "profiler.h"
+#include "trace.h"
+#include "log.h"
+
+#include <string.h>
+
+static const param_t* params;
+static uint8_t param_count;
+static bool locked = false;
+
+// Line being typed; overflowed stays set until the line ends so the rest
+// of a too-long line is not run as a command
+static char line[CONSOLE_LINE_SIZE + 1];
+static uint8_t line_length = 0;
+static bool overflowed = false;
+
+void console_init(const param_t new_params[], uint8_t n_params) {
+    params = new_params;
+    param_count = n_params;
+    line_length = 0;
+    overflowed = false;
+}
+
+void console_lock(bool new_locked) {
+    locked = new_locked;
+}
+
+static uint16_t param_get(const param_t* param) {
+    if (param->type == PARAM_U8) {
+        return *(uint8_t*)param->value;
+    }
+    return *(uint16_t*)param->value;
+}
+
+static void param_set(const param_t* param, uint16_t value) {
+    if (param->type == PARAM_U8) {
+        *(uint8_t*)param->value = (uint8_t)value;
+    }
+    else {
+        *(uint16_t*)param->value = value;
+    }
+    if (param->changed != NULL) {
+        param->changed();
+    }
+}
+
+static void print_param(uint8_t index) {
+    const param_t* param = &params[index];
+
+    // Names are on the host, by index
+    LOG_INFO(PARAM_VALUE, index, param_get(param), param->min, param->max);
+}
+
+// Returns param_count if there is no parameter with that name
+static uint8_t find_param(const char* name) {
+    uint8_t i;
+
+    for (i = 0; i < param_count; i++) {
+        if (strcmp(params[i].name, name) == 0) {
+            break;
+        }
+    }
+    return i;
+}
+
+// Decimal only; false on anything else or on overflow
+static bool parse_u16(const char* text, uint16_t* value) {
+    uint32_t result = 0;
+
+    if (*text == '\0') {
+        return false;
+    }
+    for (; *text != '\0'; text++) {
+        if (*text < '0' || *text > '9') {
+            return false;
+        }
+        result = result * 10 + (uint8_t)(*text - '0');
+        if (result > 0xFFFF) {
+            return false;
+        }
+    }
+    *value = (uint16_t)result;
+    return true;
+}
+
+// Splits off the next space-separated word in place
+static char* next_word(char** cursor) {
+    char* word = *cursor;
+
+    while (*word == ' ') {
+        word++;
+    }
+    char* end = word;
+    while (*end != ' ' && *end != '\0') {
+        end++;
+    }
+    if (*end != '\0') {
+        *end++ = '\0';
+    }
+    *cursor = end;
+    return word;
+}
+
+static void run_line(char* text) {
+    char* command = next_word(&text);
+
+    if (*command == '\0') {
+        return;
+    }
+    if (strcmp(command, "list") == 0) {
+        for (uint8_t i = 0; i < param_count; i++) {
+            print_param(i);
+        }
+        return;
+    }
+    if (strcmp(command, "profile") == 0) {
+#if PROFILE_ENABLED
+        PROFILE_DUMP_START();
+#else
+        // Say so rather than print nothing
+        LOG_WARN(CONSOLE_ERROR, CONSOLE_PROFILER_DISABLED);
+#endif
+        return;
+    }
+    if (strcmp(command, "trace") == 0) {
+        trace_dump_start();
+        return;
+    }
+
+    bool set = (strcmp(command, "set") == 0);
+    if (!set && strcmp(command, "get") != 0) {
+        LOG_WARN(CONSOLE_ERROR, CONSOLE_UNKNOWN_COMMAND);
+        return;
+    }
+
+    uint8_t index = find_param(next_word(&text));
+    if (index == param_count) {
+        LOG_WARN(CONSOLE_ERROR, CONSOLE_UNKNOWN_PARAM);
+        return;
+    }
+
+    if (set) {
+        const param_t* param = &params[index];
+        uint16_t value;
+
+        if (locked) {
+            LOG_WARN(CONSOLE_ERROR, CONSOLE_LOCKED);
+            return;
+        }
+        if (!parse_u16(next_word(&text), &value) || *next_word(&text) != '\0') {
+            LOG_WARN(CONSOLE_ERROR, CONSOLE_BAD_VALUE);
+            return;
+        }
+        if (value < param->min || value > param->max) {
+            LOG_WARN(CONSOLE_ERROR, CONSOLE_OUT_OF_RANGE);
+            return;
+        }
+        param_set(param, value);
+    }
+
+    // Echo the value so the host sees what took effect
+    print_param(index);
+}
+
+void console_run(void) {
+    while (UART1_is_rx_ready()) {
+        char c = (char)UART1_Read();
+
+        if (c != '\r' && c != '\n') {
+            if (line_length < CONSOLE_LINE_SIZE) {
+                line[line_length++] = c;
+            }
+            else {
+                overflowed = true;
+            }
+            continue;
+        }
+
+        if (overflowed) {
+            LOG_WARN(CONSOLE_ERROR, CONSOLE_LINE_TOO_LONG);
+        }
+        else {
+            line[line_length] = '\0';
+            run_line(line);
+        }
+        line_length = 0;
+        overflowed = false;
+
+        // One command per call keeps the task's run time bounded; the
+        // rest stays in the RX ring for the next period
+        return;
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Serial command console for tuning parameters without reflashing
+// Bytes are queued by the UART1 RX interrupt and parsed by console_run()
+// from a scheduler task, so typing never blocks the tick. Commands are
+// lines ended by CR or LF:
+//
+//   list                  every parameter with its limits
+//   get <name>
+//   set <name> <value>    decimal, refused outside [min, max] or while locked
+//   profile               dump the profiler, if built with PROFILE_ENABLED
+//   trace                 dump the transition trace, see trace.h
+//
+// Replies are log messages (PARAM_VALUE, CONSOLE_ERROR in log_messages.def)
+
+typedef enum {
+    PARAM_U8,
+    PARAM_U16
+} param_type_t;
+
+typedef struct {
+    const char* name;
+    param_type_t type;
+    void* value;
+    uint16_t min;
+    uint16_t max;
+    void (*changed)(void);  // called after a successful set, may be NULL
+} param_t;
+
+// Indexed like the console_error table in log_messages.def
+typedef enum {
+    CONSOLE_UNKNOWN_COMMAND,
+    CONSOLE_UNKNOWN_PARAM,
+    CONSOLE_BAD_VALUE,
+    CONSOLE_OUT_OF_RANGE,
+    CONSOLE_LOCKED,
+    CONSOLE_LINE_TOO_LONG,
+    CONSOLE_PROFILER_DISABLED   // profile in a build without PROFILE_ENABLED
+} console_error_t;
+
+// Longest command line, without the terminator
+#define CONSOLE_LINE_SIZE 40
+
+// The table stays owned by the caller and must outlive the console
+void console_init(const param_t params[], uint8_t n_params);
+
+// While locked, set is refused; get and list still work
+void console_lock(bool locked);
+
+// Call from a task. Reads what the RX ring holds and runs at most one
+// complete line
+void console_run(void);
+
+#endif // CONSOLE_H
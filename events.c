@@ -0,0 +1,69 @@
+#include "events.h"
+#include "tick.h"
+
+event_stats_t event_stats;
+
+static event_t queue[EVENT_QUEUE_SIZE];
+static volatile uint8_t head = 0;   // written only by the producer
+static volatile uint8_t tail = 0;   // written only by the consumer
+// Set by the producer, cleared by the consumer
+static volatile bool overflowed = false;
+
+void events_push_isr(event_type_t type, uint8_t value) {
+    uint8_t next = (head + 1) & (EVENT_QUEUE_SIZE - 1);
+    if (next == tail) {
+        event_stats.dropped++;
+        overflowed = true;
+        return;
+    }
+    
+    queue[head].timestamp_us = tick_get_us_isr();
+    queue[head].type = type;
+    queue[head].value = value;
+    
+    // Publish the slot only after it is filled in
+    head = next;
+}
+
+bool events_pop(event_t* event) {
+    if (tail == head) {
+        return false;
+    }
+    
+    *event = queue[tail];
+    tail = (tail + 1) & (EVENT_QUEUE_SIZE - 1);
+    
+    uint32_t latency_us = tick_get_us() - event->timestamp_us;
+    if (latency_us > event_stats.latency_max_us) {
+        event_stats.latency_max_us = latency_us;
+    }
+    
+    return true;
+}
+
+bool events_take_overflow(void) {
+    if (!overflowed) {
+        return false;
+    }
+    // Cleared before the caller re-reads the inputs, so a drop after that
+    // read sets it again
+    overflowed = false;
+    return true;
+}
+
+static void hv_switch_isr(void) {
+    events_push_isr(EVENT_HV_SWITCH, IO_RB2_GetValue());
+}
+
+static void drive_switch_isr(void) {
+    events_push_isr(EVENT_DRIVE_SWITCH, IO_RB7_GetValue());
+}
+
+void events_init(void) {
+    event_stats.dropped = 0;
+    event_stats.latency_max_us = 0;
+    overflowed = false;
+    
+    IOCBF2_SetInterruptHandler(hv_switch_isr);
+    IOCBF7_SetInterruptHandler(drive_switch_isr);
+}
@@ -0,0 +1,47 @@
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Event queue
+// ISRs timestamp input changes and push them here; the FSM task pops them.
+// Single producer (interrupt context) / single consumer (main loop), so no
+// locking is needed as long as each side only writes its own index.
+
+typedef enum {
+    EVENT_HV_SWITCH,
+    EVENT_DRIVE_SWITCH
+} event_type_t;
+
+typedef struct {
+    uint32_t timestamp_us;  // tick_get_us() when the edge was seen
+    uint8_t type;           // event_type_t
+    uint8_t value;          // new switch level
+} event_t;
+
+// Must be a power of two
+#define EVENT_QUEUE_SIZE 16
+
+typedef struct {
+    uint16_t dropped;           // events lost because the queue was full
+    uint32_t latency_max_us;    // longest time an event waited to be popped
+} event_stats_t;
+
+extern event_stats_t event_stats;
+
+// Registers the switch IOC handlers
+void events_init(void);
+
+// Producer side, only call from interrupt context
+void events_push_isr(event_type_t type, uint8_t value);
+
+// Consumer side, returns false when the queue is empty
+bool events_pop(event_t* event);
+
+// Consumer side. True, once, if events were dropped since the last call;
+// the consumer should then re-read the inputs, since a dropped edge may
+// have been the last one
+bool events_take_overflow(void);
+
+#endif // EVENTS_H
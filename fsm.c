@@ -0,0 +1,58 @@
+#include "fsm.h"
+#include "tick.h"
+
+void fsm_init(fsm_t* fsm, const fsm_state_t* table, uint8_t initial,
+        void (*on_transition)(uint8_t from, uint8_t to)) {
+    fsm->table = table;
+    fsm->current = initial;
+    fsm->previous = initial;
+    fsm->on_transition = on_transition;
+    fsm->transition_us = 0;
+    fsm->transition_max_us = 0;
+    
+    if (table[initial].entry) {
+        table[initial].entry();
+    }
+}
+
+bool fsm_step(fsm_t* fsm) {
+    const fsm_state_t* row = &fsm->table[fsm->current];
+    
+    if (row->during) {
+        row->during();
+    }
+    
+    for (uint8_t i = 0; i < row->n_transitions; i++) {
+        const fsm_transition_t* t = &row->transitions[i];
+        if (!t->guard()) {
+            continue;
+        }
+        
+        uint8_t target = (t->target == FSM_PREVIOUS) ? fsm->previous : t->target;
+        uint32_t start_us = tick_get_us();
+        
+        if (row->exit) {
+            row->exit();
+        }
+        
+        fsm->previous = fsm->current;
+        fsm->current = target;
+        if (fsm->on_transition) {
+            fsm->on_transition(fsm->previous, target);
+        }
+        
+        if (fsm->table[target].entry) {
+            fsm->table[target].entry();
+        }
+        
+        uint32_t elapsed_us = tick_get_us() - start_us;
+        fsm->transition_us = (elapsed_us > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed_us;
+        if (fsm->transition_us > fsm->transition_max_us) {
+            fsm->transition_max_us = fsm->transition_us;
+        }
+        
+        return true;
+    }
+    
+    return false;
+}
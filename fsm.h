@@ -0,0 +1,50 @@
+#ifndef FSM_H
+#define FSM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Table-driven state machine engine
+// Each row of a const state table (program memory) lists its entry, during
+// and exit actions plus an ordered list of guarded transitions. A step costs
+// one table lookup for the current row, then the transitions are checked in
+// order and the first guard that passes wins.
+
+// Transition target meaning "go back to the row we came from"
+#define FSM_PREVIOUS 0xFF
+
+typedef struct {
+    bool (*guard)(void);
+    uint8_t target;         // row index or FSM_PREVIOUS
+} fsm_transition_t;
+
+typedef struct {
+    uint8_t state;          // state reported for this row
+    uint8_t error;          // error reported for this row
+    void (*entry)(void);    // any action may be NULL
+    void (*during)(void);   // runs every step before the guards are checked
+    void (*exit)(void);
+    const fsm_transition_t* transitions;
+    uint8_t n_transitions;
+} fsm_state_t;
+
+#define FSM_TRANSITIONS(t) (t), (sizeof(t) / sizeof((t)[0]))
+
+typedef struct {
+    const fsm_state_t* table;
+    uint8_t current;
+    uint8_t previous;
+    // Called after the exit action of the old row and before the entry
+    // action of the new one
+    void (*on_transition)(uint8_t from, uint8_t to);
+    uint16_t transition_us;     // exit + entry cost of the last transition
+    uint16_t transition_max_us;
+} fsm_t;
+
+void fsm_init(fsm_t* fsm, const fsm_state_t* table, uint8_t initial,
+        void (*on_transition)(uint8_t from, uint8_t to));
+
+// Runs the current row once; returns true if a transition was taken
+bool fsm_step(fsm_t* fsm);
+
+#endif // FSM_H
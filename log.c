@@ -0,0 +1,38 @@
+#include "log.h"
+#include "telemetry.h"
+
+#include <stdarg.h>
+
+// Level, token, then up to 5 bytes per varint
+#define LOG_MAX_RECORD (2 + LOG_MAX_ARGS * 5)
+
+void log_write(uint8_t level, log_token_t token, uint8_t count, ...) {
+    uint8_t record[LOG_MAX_RECORD];
+    uint8_t length = 0;
+    va_list args;
+    
+    record[length++] = level;
+    record[length++] = (uint8_t)token;
+    
+    // Unsigned LEB128: 7 bits per byte, low bits first, top bit set on all
+    // but the last byte, so small values (most of them) take one byte
+    va_start(args, count);
+    for (uint8_t i = 0; i < count && i < LOG_MAX_ARGS; i++) {
+        uint32_t value = va_arg(args, uint32_t);
+        do {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            if (value) {
+                byte |= 0x80;
+            }
+            record[length++] = byte;
+        } while (value);
+    }
+    va_end(args);
+    
+    telemetry_send(TELEMETRY_FRAME_LOG, record, length);
+}
+
+bool log_can_write(void) {
+    return telemetry_can_send(LOG_MAX_RECORD);
+}
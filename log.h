@@ -0,0 +1,86 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Tokenized logging
+// A call site sends only its message token and raw argument values inside
+// a telemetry frame; the format strings live in log_messages.def and are
+// applied on the host by tools/telemetry_decode.py. No printf runs on the
+// MCU. Sites below LOG_LEVEL are removed by the preprocessor, arguments and
+// all.
+//
+//     LOG_INFO(TICK_STATS, latency_min_us, latency_max_us, overruns);
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE 4
+
+// Build with e.g. LOG_LEVEL=0 to get the debug sites back
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+typedef enum {
+#define LOG_MESSAGE(name, format) LOG_##name,
+#define LOG_TABLE(name, ...)
+#include "log_messages.def"
+#undef LOG_MESSAGE
+#undef LOG_TABLE
+    LOG_MESSAGE_COUNT
+} log_token_t;
+
+// Arguments are widened to 32 bits and sent as varints
+#define LOG_MAX_ARGS 5
+
+void log_write(uint8_t level, log_token_t token, uint8_t count, ...);
+
+// Whether a record of any length would fit in the UART ring now, for
+// senders that pace a burst of records instead of losing its tail
+bool log_can_write(void);
+
+// Picks LOG_WRITEn by argument count (name included)
+#define LOG_WRITE(level, ...) \
+    LOG_SELECT(__VA_ARGS__, LOG_WRITE5, LOG_WRITE4, LOG_WRITE3, LOG_WRITE2, LOG_WRITE1, LOG_WRITE0, _)(level, __VA_ARGS__)
+#define LOG_SELECT(_0, _1, _2, _3, _4, _5, name, ...) name
+#define LOG_WRITE0(level, name) \
+    log_write(level, LOG_##name, 0)
+#define LOG_WRITE1(level, name, a) \
+    log_write(level, LOG_##name, 1, (uint32_t)(a))
+#define LOG_WRITE2(level, name, a, b) \
+    log_write(level, LOG_##name, 2, (uint32_t)(a), (uint32_t)(b))
+#define LOG_WRITE3(level, name, a, b, c) \
+    log_write(level, LOG_##name, 3, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c))
+#define LOG_WRITE4(level, name, a, b, c, d) \
+    log_write(level, LOG_##name, 4, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d))
+#define LOG_WRITE5(level, name, a, b, c, d, e) \
+    log_write(level, LOG_##name, 5, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d), (uint32_t)(e))
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOG_WRITE(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_WRITE(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) LOG_WRITE(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOG_WRITE(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...)
+#endif
+
+#endif // LOG_H
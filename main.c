@@ -1,4 +1,20 @@
 #include "mcc_generated_files/mcc.h"
+#include "tick.h"
+#include "scheduler.h"
+#include "events.h"
+#include "fsm.h"
+#include "profiler.h"
+#include "clock.h"
+#include "adc_scan.h"
+#include "pedal_math.h"
+#include "torque_map.h"
+#include "telemetry.h"
+#include "log.h"
+#include "console.h"
+#include "trace.h"
+#include "can_tx.h"
+#include "can_rx.h"
+#include "torque_cmd.h"
 
 #include <string.h>
 #include <time.h>
@@ -20,30 +36,90 @@ typedef enum {
     BRAKE_NOT_PRESSED,
     HV_DISABLED_WHILE_DRIVING,
     SENSOR_DISCREPANCY,
-    BRAKE_IMPLAUSIBLE
+    BRAKE_IMPLAUSIBLE,
+    SENSOR_OUT_OF_RANGE
 } error_t;
 
 // Controls
 
 // Switches
 // 0 means off, 1 means on
+// Levels are latched from IOC events instead of polling RB2/RB7
+
+uint8_t hv_switch = 0;
+uint8_t drive_switch = 0;
+
+static void read_switches() {
+    hv_switch = IO_RB2_GetValue();
+    drive_switch = IO_RB7_GetValue();
+}
 
 uint8_t is_hv_requested() {
-    return IO_RB2_GetValue();
+    return hv_switch;
 }
 
 uint8_t is_drive_requested() {
-    return IO_RB7_GetValue();
+    return drive_switch;
+}
+
+void init_switches() {
+    // Edges after this point are queued by the IOC handlers
+    read_switches();
+    events_init();
+}
+
+// Apply queued switch edges in the order they happened
+void process_events() {
+    event_t event;
+    
+    while (events_pop(&event)) {
+        switch (event.type) {
+            case EVENT_HV_SWITCH:
+                hv_switch = event.value;
+                break;
+            case EVENT_DRIVE_SWITCH:
+                drive_switch = event.value;
+                break;
+        }
+    }
+    
+    // A full queue drops the newest edges, and the levels latched above
+    // may be stale until the switch moves again; the pins are current
+    if (events_take_overflow()) {
+        read_switches();
+    }
 }
 
 // Pedals
 // On the breadboard, the range of values for the potentiometer is 0 to 4095
+// The ADC oversamples, so readings carry ADC_EXTRA_BITS more (0 to 16380)
 
-#define PEDAL_MAX 4095
+#define PEDAL_MAX ADC_RESULT_MAX
 
 // There is some noise when reading from the brake pedal
 // So give some room for error when driver presses on brake
-#define BRAKE_ERROR_TOLERANCE 50
+// (50 counts at 12 bits; the brake channel is now low-pass filtered by the ADC)
+#define BRAKE_ERROR_TOLERANCE (50 << ADC_EXTRA_BITS)
+
+// A reading this far past the travel seen in calibration means an open or
+// shorted sensor. The window stops at the rails, so a pot that reaches them
+// (the breadboard's read 0 released and PEDAL_MAX fully pressed) is only
+// checked at the ends that do not. The brake has no upper limit since
+// pressing it reads near PEDAL_MAX. Build with a different value to suit
+// the pedal box
+#ifndef SENSOR_RANGE_MARGIN
+#define SENSOR_RANGE_MARGIN (20 << ADC_EXTRA_BITS)
+#endif
+
+// Throttle sensors may disagree by this many percentage points
+#define DISCREPANCY_PERCENT 10
+// BSPD throttle limit while braking, percent of the throttle range
+#define BSPD_THROTTLE_PERCENT 25
+
+// Start at the defaults above; tunable over the serial console, see PARAMS
+uint16_t brake_error_tolerance = BRAKE_ERROR_TOLERANCE;
+uint8_t discrepancy_percent = DISCREPANCY_PERCENT;
+uint8_t bspd_throttle_percent = BSPD_THROTTLE_PERCENT;
 
 
 uint16_t throttle1 = 0;
@@ -53,20 +129,52 @@ uint16_t throttle1_min = 0x7FFF;
 uint16_t throttle2_max = 0;
 uint16_t throttle2_min = 0x7FFF;
 uint16_t throttle_range = 0; // set after max and min values are calibrated
-uint16_t per_throttle1 = 0;
-uint16_t per_throttle2 = 0;
+uint16_t brake_dead_zone = 0; // 1/6 of throttle_range, set with it
+uint8_t per_throttle1 = 0;
+uint8_t per_throttle2 = 0;
+// Compiled from the calibration when it ends
+pedal_scale_t throttle1_scale;
+pedal_scale_t throttle2_scale;
+
+// Torque command from the selected map, only non-zero in DRIVE
+uint16_t torque_request = 0;
+// A torque_map_mode_t, tunable over the console while not in DRIVE
+uint8_t torque_map_mode = TORQUE_MAP_ENDURANCE;
+
+void apply_torque_map() {
+    torque_map_select((torque_map_mode_t)torque_map_mode);
+}
 
 uint16_t brake = 0;
+// tick_get_us() when the ADC scan of the values above completed, for CAN latency
+uint32_t sensor_sample_us = 0;
 uint16_t brake_max = 0;
 uint16_t brake_min = 0;
 uint16_t brake_range = 0;
 
+// Limits are checked on every scan, see adc_scan.h
+// Re-run when calibration ends and when brake_error_tolerance is changed;
+// until the first calibration ends nothing is out of range
+void init_sensor_thresholds() {
+    pedal_window_t window;
+    
+    pedal_window_init(&window, throttle1_min, throttle1_max, SENSOR_RANGE_MARGIN, PEDAL_MAX);
+    adc_scan_set_thresholds(SCAN_THROTTLE1, window.lower, window.upper);
+    pedal_window_init(&window, throttle2_min, throttle2_max, SENSOR_RANGE_MARGIN, PEDAL_MAX);
+    adc_scan_set_thresholds(SCAN_THROTTLE2, window.lower, window.upper);
+    // Above the upper threshold means the brake is pressed. The check is a
+    // strict >, so one less gives brake >= PEDAL_MAX - brake_error_tolerance.
+    // The ADCC compares the low-pass brake at 12 bits, so that holds for a
+    // tolerance in whole 12-bit counts, as the default is
+    pedal_window_init(&window, brake_min, brake_max, SENSOR_RANGE_MARGIN, PEDAL_MAX);
+    adc_scan_set_thresholds(SCAN_BRAKE, window.lower, PEDAL_MAX - brake_error_tolerance - 1);
+}
+
 // How long to wait for pre-charging to finish before timing out
 #define MAX_CONSERVATION_SECS 4
-// Keeps track of timer waiting for pre-charging
-unsigned int conservative_timer_ms = 0;
-// Delay between checking pre-charging state
-#define AWAIT_PRECHARGING_DELAY_MS 100
+uint8_t max_conservation_secs = MAX_CONSERVATION_SECS;
+// Tick time when pre-charging started
+uint32_t precharge_start_ms = 0;
 
 // High voltage state variables
 #define DRIVE_REQ_DELAY_MS 1000
@@ -75,44 +183,6 @@ unsigned int conservative_timer_ms = 0;
 state_t state = LV;
 error_t error = NONE;
 
-const char* STATE_NAMES[] = {
-    "LV", 
-    "PRECHARGING", 
-    "HV_ENABLED", 
-    "DRIVE", 
-    "FAULT"
-};
-const char* ERROR_NAMES[] = {
-    "NONE", 
-    "DRIVE_REQUEST_FROM_LV", 
-    "CONSERVATIVE_TIMER_MAXED", 
-    "BRAKE_NOT_PRESSED", 
-    "HV_DISABLED_WHILE_DRIVE",
-    "SENSOR_DISCREPANCY",
-    "BRAKE_IMPLAUSIBLE"
-};
-
-void change_state(const state_t new_state) {
-    // Handle edge cases
-    if (state == FAULT && new_state != FAULT) {
-        // Reset the error cause when exiting fault state
-        error = NONE;
-    }
-        
-    // Print state transition
-    printf("%s -> %s\r\n", STATE_NAMES[state], STATE_NAMES[new_state]);
-    
-    state = new_state;
-}
-
-void report_fault(error_t _error) {
-    change_state(FAULT);
-    
-    printf("Error: %s\r\n", ERROR_NAMES[_error]);
-    
-    // Cause of error
-    error = _error;
-}
 
 
 bool start_calibration = true;
@@ -129,10 +199,7 @@ void run_calibration() {
         start_calibration = false;
     }
     else {
-        throttle1 = ADCC_GetSingleConversion(channel_ANB0);
-        throttle2 = ADCC_GetSingleConversion(channel_ANB1);
-        brake = ADCC_GetSingleConversion(channel_ANB5);
-
+        // Samples come from the update_sensor_vals() task
         if (throttle1 > throttle1_max) {
             throttle1_max = throttle1;
         }
@@ -152,108 +219,572 @@ void run_calibration() {
         if (brake < brake_min) {
             brake_min = brake;
         }    
-
-         printf("throttle1: %d\r\n", throttle1);
-         printf("throttle1_max: %d\r\n", throttle1_max);
-         printf("throttle1_min: %d\r\n", throttle1_min); 
-         printf("throttle2: %d\r\n", throttle2);         
-         printf("throttle2_max: %d\r\n", throttle2_max);
-         printf("throttle2_min: %d\r\n", throttle2_min);
-         printf("brake: %d\r\n", brake);
-         printf("brake_max: %d\r\n", brake_max);
-         printf("brake_min: %d\r\n", brake_min);
     }
 }
 
 // check differential between the throttle sensors
-// returns true only if the sensor discrepancy is > 10%
+// returns true only if the sensor discrepancy is > discrepancy_percent
 // Note: after verifying there's no discrepancy, can use either sensor(1 or 2) for remaining checks
 bool has_discrepancy() {
-    // check throttle
+    PROFILE_BEGIN(profile_start);
     
-    // calculate percentage of throttle 1
-    uint16_t temp_throttle1 = throttle1;
-    if (temp_throttle1 > throttle1_max) {
-        temp_throttle1 = throttle1_max;
-    } else if (temp_throttle1 < throttle1_min) {
-        temp_throttle1 = throttle1_min;
-    }
-    per_throttle1 = (uint16_t)(((double)(temp_throttle1-throttle1_min) / (throttle1_max - throttle1_min)) * 100);
+    // percentage of each throttle over its calibrated range
+    per_throttle1 = pedal_scale_percent(&throttle1_scale, throttle1);
+    per_throttle2 = pedal_scale_percent(&throttle2_scale, throttle2);
     
-    // calculate percentage of throttle 2
-    uint16_t temp_throttle2 = throttle2;
-    if (temp_throttle2 > throttle2_max) {
-        temp_throttle2 = throttle2_max;
-    } else if( temp_throttle2 < throttle2_min) {
-        temp_throttle2 = throttle2_min;
-    }
-    per_throttle2 = (uint16_t)(((double)(temp_throttle2-throttle2_min) / (throttle2_max - throttle2_min)) * 100);
+    bool discrepancy = pedal_differ(per_throttle1, per_throttle2, discrepancy_percent);
     
-    return abs((int)per_throttle1 - (int)per_throttle2) > 10;
+    PROFILE_END(profile_start, PROFILE_HAS_DISCREPANCY);
+    return discrepancy;
 }
 
 // check for soft BSPD
 // see EV.5.7 of FSAE 2022 rulebook
 bool brake_implausible() {
+    PROFILE_BEGIN(profile_start);
+    
     uint16_t temp_throttle = throttle1; 
     
     // subtract dead zone 15%
-    uint16_t temp_brake = brake - ((throttle_range)/6);
+    uint16_t temp_brake = brake - brake_dead_zone;
     if (temp_brake > brake_max){
         temp_brake = brake_max;
     }
     if (temp_brake < brake_min){
         temp_brake = brake_min;
     }
-    temp_brake = (uint16_t)((temp_brake-brake_min)*100.0 / throttle_range);
+    // Relative to the throttle range, as before; only > 0 matters, so the
+    // clamp to 100 changes nothing
+    temp_brake = pedal_scale_percent_of(&throttle1_scale, temp_brake - brake_min);
     
     
+    bool implausible;
     if (state == FAULT && error == BRAKE_IMPLAUSIBLE) {
         // once brake implausibility detected, can only revert to normal if throttle unapplied
-        return !(temp_throttle < throttle_range * 0.25);
+        implausible = !pedal_below_percent(temp_throttle, throttle_range, bspd_throttle_percent);
     }
     else {
         // if both brake and throttle applied, brake implausible
-        return (temp_brake > 0 && temp_throttle > throttle_range * 0.25);
+        implausible = (temp_brake > 0 && pedal_above_percent(temp_throttle, throttle_range, bspd_throttle_percent));
     }
     
+    PROFILE_END(profile_start, PROFILE_BRAKE_IMPLAUSIBLE);
+    return implausible;
 }
 
-// storage variables used to return to previous state when discrepancy is resolved
-state_t temp_state = LV; // state before sensor discrepancy error
-error_t temp_error = NONE; // error state before sensor discrepancy error (only used when going from one fault to discrepancy fault)
-
 void update_sensor_vals() {
-    throttle1 = ADCC_GetSingleConversion(channel_ANB0);
-    throttle2 = ADCC_GetSingleConversion(channel_ANB1); 
-    brake = ADCC_GetSingleConversion(channel_ANB5);
+    PROFILE_BEGIN(profile_start);
     
-     printf("State: %s\r\n", STATE_NAMES[state]);
-     printf("Throttle 1: %d\r\n", throttle1);
-     printf("Throttle 2: %d\r\n", throttle2);
-     printf("Brake: %d\r\n", brake);
-
-   if (error != SENSOR_DISCREPANCY && has_discrepancy() ) {
-       temp_state = state;
-       temp_error = error;
-       report_fault(SENSOR_DISCREPANCY);
-   }
+    // The scan runs on TMR2, so this only picks up the latest set
+    adc_result_t results[SCAN_CHANNEL_COUNT];
+    adc_scan_read(results, &sensor_sample_us);
+    throttle1 = results[SCAN_THROTTLE1];
+    throttle2 = results[SCAN_THROTTLE2];
+    brake = results[SCAN_BRAKE];
+    
+    PROFILE_END(profile_start, PROFILE_UPDATE_SENSOR_VALS);
 }
 
 
-// TODO: write function to process and send pedal and brake data over CAN
-// see CY_ISR(isr_CAN_Handler) in pedal node
+// CAN
+// Published from the latest sensor values; the layouts are in can.dbc
+
+void publish_can() {
+    uCAN_MSG msg;
+    vcu_pedals_t pedals = { throttle1, throttle2, brake };
+    vcu_state_t status = { (uint8_t)state, (uint8_t)error, torque_request };
+    
+    vcu_pedals_pack(&msg, &pedals);
+    can_tx_queue(&msg, sensor_sample_us);
+    
+    vcu_state_pack(&msg, &status);
+    can_tx_queue(&msg, sensor_sample_us);
+}
+
+// Sent every TORQUE_CMD_PERIOD_MS, after run_fsm() has checked the same
+// sensor values and set torque_request from them
+void command_torque() {
+    torque_cmd_send(torque_request, state == DRIVE, sensor_sample_us);
+}
 
 // TODO: write functions to save and load calibration data
 // see EEPROM functions in pedal node
 // probably dont need this if we are always recalibrating on startup/lv
 
+// Main FSM
+// Source: https://docs.google.com/document/d/1q0RL4FmDfVuAp6xp9yW7O-vIvnkwoAXWssC3-vBmNGM/edit?usp=sharing
+
+// Rows of the FSM table; every fault cause has its own row
+typedef enum {
+    ROW_LV,
+    ROW_PRECHARGING,
+    ROW_HV_ENABLED,
+    ROW_DRIVE,
+    ROW_DRIVE_REQUEST_FROM_LV,
+    ROW_CONSERVATIVE_TIMER_MAXED,
+    ROW_BRAKE_NOT_PRESSED,
+    ROW_HV_DISABLED_WHILE_DRIVING,
+    ROW_SENSOR_DISCREPANCY,
+    ROW_BRAKE_IMPLAUSIBLE,
+    ROW_SENSOR_OUT_OF_RANGE,
+    ROW_COUNT
+} fsm_row_t;
+
+// Guards
+
+bool hv_on() {
+    return is_hv_requested();
+}
+
+bool hv_off() {
+    return !is_hv_requested();
+}
+
+bool drive_on() {
+    return is_drive_requested();
+}
+
+bool drive_off() {
+    return !is_drive_requested();
+}
+
+bool hv_and_drive_off() {
+    // Drive and HV switch must both be reset to revert to LV
+    return !is_hv_requested() && !is_drive_requested();
+}
+
+bool precharge_timed_out() {
+    return tick_get_ms() - precharge_start_ms >= max_conservation_secs * 1000UL;
+}
+
+// Build with PRECHARGE_BYPASS=1 to test on the breadboard without a motor controller
+#ifndef PRECHARGE_BYPASS
+#define PRECHARGE_BYPASS 0
+#endif
+
+bool precharge_done() {
+#if PRECHARGE_BYPASS
+    return true;
+#else
+    // Motor controller reports the DC bus charged, see can_rx.h
+    return can_rx_precharged();
+#endif
+}
+
+bool drive_with_brake() {
+    // Need to press on pedal at the same time to go to drive
+    return is_drive_requested() && adc_scan_above(SCAN_BRAKE);
+}
+
+bool sensor_out_of_range() {
+    return adc_scan_below(SCAN_THROTTLE1) || adc_scan_above(SCAN_THROTTLE1)
+        || adc_scan_below(SCAN_THROTTLE2) || adc_scan_above(SCAN_THROTTLE2)
+        || adc_scan_below(SCAN_BRAKE);
+}
+
+bool sensors_in_range() {
+    return !sensor_out_of_range();
+}
+
+bool discrepancy_resolved() {
+    // TODO: stop power to motors if discrepancy persists for >100ms
+    // see rule T.4.2.5 in FSAE 2022 rulebook
+    return !has_discrepancy();
+}
+
+bool brake_plausible() {
+    return !brake_implausible();
+}
+
+// CPU load
+// Time not spent idle in tick_wait() over wall time, so interrupts count
+// as load as well as tasks. Kept apart for each clock profile so the two
+// can be compared. A window shorter than CPU_LOAD_MIN_US carries over
+// into the next one instead of giving a noisy figure
+
+#define CPU_LOAD_MIN_US 1000000UL
+
+typedef struct {
+    uint32_t busy_us;
+    uint32_t elapsed_us;
+    uint16_t permille;      // of the last full window, 0 until there is one
+} cpu_load_t;
+
+cpu_load_t cpu_load[CLOCK_PROFILE_COUNT];
+uint32_t cpu_load_start_us = 0;
+
+// Charges the time since the last call to the current profile; call
+// before switching profile
+void account_cpu_load() {
+    uint32_t now = tick_get_us();
+    cpu_load_t* load = &cpu_load[clock_get_profile()];
+    uint32_t elapsed_us = now - cpu_load_start_us;
+    uint32_t idle_us = tick_take_idle_us();
+    
+    // Idle and wall time come from different timers; do not let the
+    // rounding underflow
+    load->busy_us += (elapsed_us > idle_us) ? elapsed_us - idle_us : 0;
+    load->elapsed_us += elapsed_us;
+    cpu_load_start_us = now;
+}
+
+// Closes the windows that are long enough
+void update_cpu_load() {
+    account_cpu_load();
+    for (uint8_t i = 0; i < CLOCK_PROFILE_COUNT; i++) {
+        cpu_load_t* load = &cpu_load[i];
+        
+        if (load->elapsed_us >= CPU_LOAD_MIN_US) {
+            load->permille = (uint16_t)(load->busy_us / (load->elapsed_us / 1000));
+            load->busy_us = 0;
+            load->elapsed_us = 0;
+        }
+    }
+}
+
+// Actions
+
+void enter_lv() {
+    // Nothing time-critical runs in LV
+    account_cpu_load();
+    clock_set_profile(CLOCK_LOW_POWER);
+}
+
+void enter_drive() {
+    account_cpu_load();
+    clock_set_profile(CLOCK_FULL_SPEED);
+    // Limits only change while the car cannot be driven
+    console_lock(true);
+}
+
+void drive() {
+    // Throttle 1 stands for both once has_discrepancy() has passed
+    torque_request = torque_map_lookup(pedal_scale_percent(&throttle1_scale, throttle1));
+}
+
+void exit_drive() {
+    torque_request = 0;
+    console_lock(false);
+}
+
+void start_precharging() {
+    // Set throttle and brake range since calibration is done, and do the
+    // divisions here once instead of on every check
+    throttle_range = throttle1_max - throttle1_min;
+    brake_dead_zone = throttle_range / 6;
+    brake_range = brake_max - brake_min; // idk where this is even used
+    pedal_scale_init(&throttle1_scale, throttle1_min, throttle1_max);
+    pedal_scale_init(&throttle2_scale, throttle2_min, throttle2_max);
+    init_sensor_thresholds();
+    
+    precharge_start_ms = tick_get_ms();
+}
+
+// Transitions, checked in order
+
+const fsm_transition_t LV_TRANSITIONS[] = {
+    // Drive switch should not be enabled during LV
+    { drive_on,             ROW_DRIVE_REQUEST_FROM_LV },
+    // Start charging the car to high voltage state
+    { hv_on,                ROW_PRECHARGING },
+};
+const fsm_transition_t PRECHARGING_TRANSITIONS[] = {
+    { precharge_timed_out,  ROW_CONSERVATIVE_TIMER_MAXED },
+    { precharge_done,       ROW_HV_ENABLED },
+};
+const fsm_transition_t HV_ENABLED_TRANSITIONS[] = {
+    { sensor_out_of_range,  ROW_SENSOR_OUT_OF_RANGE },
+    { has_discrepancy,      ROW_SENSOR_DISCREPANCY },
+    // TODO: or capacitor voltage went under threshold
+    { hv_off,               ROW_LV },
+    { drive_with_brake,     ROW_DRIVE },
+    // Driver didn't press pedal
+    { drive_on,             ROW_BRAKE_NOT_PRESSED },
+};
+const fsm_transition_t DRIVE_TRANSITIONS[] = {
+    { sensor_out_of_range,  ROW_SENSOR_OUT_OF_RANGE },
+    { has_discrepancy,      ROW_SENSOR_DISCREPANCY },
+    // Revert to HV
+    { drive_off,            ROW_HV_ENABLED },
+    // HV switched flipped off, so can't drive
+    { hv_off,               ROW_HV_DISABLED_WHILE_DRIVING },
+    { brake_implausible,    ROW_BRAKE_IMPLAUSIBLE },
+};
+const fsm_transition_t DRIVE_REQUEST_FROM_LV_TRANSITIONS[] = {
+    { drive_off,            ROW_LV },
+};
+const fsm_transition_t CONSERVATIVE_TIMER_MAXED_TRANSITIONS[] = {
+    { hv_and_drive_off,     ROW_LV },
+};
+const fsm_transition_t BRAKE_NOT_PRESSED_TRANSITIONS[] = {
+    // Ask driver to reset drive switch and try again
+    { drive_off,            ROW_HV_ENABLED },
+};
+const fsm_transition_t HV_DISABLED_WHILE_DRIVING_TRANSITIONS[] = {
+    { has_discrepancy,      ROW_SENSOR_DISCREPANCY },
+    // Ask driver to flip off drive switch to properly go back to LV
+    { drive_off,            ROW_LV },
+};
+const fsm_transition_t SENSOR_DISCREPANCY_TRANSITIONS[] = {
+    // Change back to the state (or fault) we came from
+    { discrepancy_resolved, FSM_PREVIOUS },
+};
+const fsm_transition_t BRAKE_IMPLAUSIBLE_TRANSITIONS[] = {
+    { has_discrepancy,      ROW_SENSOR_DISCREPANCY },
+    // Only reverts once the throttle is released
+    { brake_plausible,      ROW_DRIVE },
+};
+const fsm_transition_t SENSOR_OUT_OF_RANGE_TRANSITIONS[] = {
+    // Change back to the state (or fault) we came from
+    { sensors_in_range,     FSM_PREVIOUS },
+};
+
+// Indexed by fsm_row_t
+const fsm_state_t FSM_TABLE[] = {
+    // state        error                       entry               during           exit
+    { LV,           NONE,                       enter_lv,           run_calibration, NULL,       FSM_TRANSITIONS(LV_TRANSITIONS) },
+    { PRECHARGING,  NONE,                       start_precharging,  NULL,            NULL,       FSM_TRANSITIONS(PRECHARGING_TRANSITIONS) },
+    { HV_ENABLED,   NONE,                       NULL,               NULL,            NULL,       FSM_TRANSITIONS(HV_ENABLED_TRANSITIONS) },
+    { DRIVE,        NONE,                       enter_drive,        drive,           exit_drive, FSM_TRANSITIONS(DRIVE_TRANSITIONS) },
+    { FAULT,        DRIVE_REQUEST_FROM_LV,      NULL,               NULL,            NULL,       FSM_TRANSITIONS(DRIVE_REQUEST_FROM_LV_TRANSITIONS) },
+    { FAULT,        CONSERVATIVE_TIMER_MAXED,   NULL,               NULL,            NULL,       FSM_TRANSITIONS(CONSERVATIVE_TIMER_MAXED_TRANSITIONS) },
+    { FAULT,        BRAKE_NOT_PRESSED,          NULL,               NULL,            NULL,       FSM_TRANSITIONS(BRAKE_NOT_PRESSED_TRANSITIONS) },
+    { FAULT,        HV_DISABLED_WHILE_DRIVING,  NULL,               NULL,            NULL,       FSM_TRANSITIONS(HV_DISABLED_WHILE_DRIVING_TRANSITIONS) },
+    { FAULT,        SENSOR_DISCREPANCY,         NULL,               NULL,            NULL,       FSM_TRANSITIONS(SENSOR_DISCREPANCY_TRANSITIONS) },
+    { FAULT,        BRAKE_IMPLAUSIBLE,          NULL,               NULL,            NULL,       FSM_TRANSITIONS(BRAKE_IMPLAUSIBLE_TRANSITIONS) },
+    { FAULT,        SENSOR_OUT_OF_RANGE,        NULL,               NULL,            NULL,       FSM_TRANSITIONS(SENSOR_OUT_OF_RANGE_TRANSITIONS) },
+};
+
+// Build-time checks (an array of size -1 does not compile): one row per
+// fsm_row_t, and one profiler site per row
+typedef char fsm_table_size_check[sizeof(FSM_TABLE) / sizeof(FSM_TABLE[0]) == ROW_COUNT ? 1 : -1];
+typedef char profile_fsm_rows_check[PROFILE_FSM_ROWS == ROW_COUNT ? 1 : -1];
+
+fsm_t fsm;
+
+void change_state(uint8_t from, uint8_t to) {
+    state = FSM_TABLE[to].state;
+    error = FSM_TABLE[to].error;
+    
+    // Kept in RAM for the console's "trace" dump
+    trace_entry_t* entry = trace_next();
+    entry->time_ms = tick_get_ms();
+    entry->from_state = FSM_TABLE[from].state;
+    entry->from_error = FSM_TABLE[from].error;
+    entry->to_state = state;
+    entry->to_error = error;
+    entry->throttle1 = throttle1;
+    entry->throttle2 = throttle2;
+    entry->brake = brake;
+    
+    // Names are looked up on the host, see tools/telemetry_decode.py
+    telemetry_transition(FSM_TABLE[from].state, FSM_TABLE[from].error, state, error);
+}
+
+void run_fsm() {
+    process_events();
+    
+    #if PROFILE_ENABLED
+    // Profiled against the row that was current when the step started
+    uint8_t row = fsm.current;
+    #endif
+    PROFILE_BEGIN(profile_start);
+    fsm_step(&fsm);
+    PROFILE_END(profile_start, PROFILE_FSM_ROW + row);
+}
+
+// Binary telemetry over UART, batched into frames of TELEMETRY_BATCH samples
+void sample_telemetry() {
+    telemetry_sample(throttle1, throttle2, brake, state, error, torque_request);
+}
+
+void run_housekeeping();
+
+void run_console() {
+    console_run();
+    trace_dump_run();
+    PROFILE_DUMP_RUN();
+}
+
+// Tasks in priority order; the host names them by index from the task
+// LOG_TABLE in log_messages.def, so keep the two in the same order.
+// Budgets are for the 8 MHz low-power clock. Logs, telemetry and CAN only queue into
+// the UART1 TX ring and CAN TX slots, so no task waits on the 9600 baud line or the
+// bus; whatever does not fit is dropped or replaced, and counted
+const task_t TASKS[] = {
+    // run                period_ms   budget_us
+    // Matches ADC_SCAN_PERIOD_US
+    { update_sensor_vals, 2,          50 },
+    { run_fsm,            2,          100 },
+    // Matches TORQUE_CMD_PERIOD_MS, in the same tick as the two above so
+    // pedal to frame is a single pass
+    { command_torque,     2,          300 },
+    // Every fifth sensor tick, after fsm and torque, so the frames carry the
+    // state and torque request that go with the sensor values
+    { publish_can,        10,         100 },
+    // ~111 samples/s, 10x the old text dumps, in ~760 B/s of frames,
+    // leaving room for the text below
+    { sample_telemetry,   9,          150 },
+    // Sends one frame of the HOUSEKEEPING_REPORT_MS report per run
+    { run_housekeeping,   20,         300 },
+    // Runs at most one command and sends at most one trace entry and one
+    // profiler line per period
+    { run_console,        20,         300 },
+};
+#define TASK_COUNT (sizeof(TASKS) / sizeof(TASKS[0]))
+
+task_stats_t task_stats[TASK_COUNT];
+
+// Tunable over the serial console; indexed like the param table in log_messages.def
+// Limits keep every check meaningful, e.g. the brake-pressed threshold
+// stays in the upper half of the ADC range
+const param_t PARAMS[] = {
+    // name                     type        value                       min                     max                     changed
+    { "brake_error_tolerance",  PARAM_U16,  &brake_error_tolerance,     1 << ADC_EXTRA_BITS,    PEDAL_MAX / 2,          init_sensor_thresholds },
+    { "discrepancy_percent",    PARAM_U8,   &discrepancy_percent,       1,                      100,                    NULL },
+    { "bspd_throttle_percent",  PARAM_U8,   &bspd_throttle_percent,     1,                      100,                    NULL },
+    { "max_conservation_secs",  PARAM_U8,   &max_conservation_secs,     1,                      60,                     NULL },
+    // Indexed like the torque_map table in log_messages.def
+    { "torque_map",             PARAM_U8,   &torque_map_mode,           0,                      TORQUE_MAP_COUNT - 1,   apply_torque_map },
+};
+#define PARAM_COUNT (sizeof(PARAMS) / sizeof(PARAMS[0]))
+
+// Scheduler health, printed so overruns are visible on the serial console
+// The report is about 20 log frames, more than the UART ring holds, so it
+// goes out one frame per run and only when the frame fits, like the trace
+// dump, instead of losing its tail every time
+
+#define HOUSEKEEPING_REPORT_MS 5000
+
+// One log frame each, in order
+typedef enum {
+    REPORT_TICK,
+    REPORT_FSM,
+    REPORT_EVENTS,
+    REPORT_UART,
+    REPORT_TELEMETRY,
+    REPORT_CAN,
+    REPORT_INVERTER,
+    REPORT_TORQUE_CMD,
+    REPORT_TORQUE_CMD_AGES,
+    REPORT_TORQUE_MAP,
+    REPORT_TASK,        // first of TASK_COUNT, indexed like TASKS
+    REPORT_CPU_LOAD = REPORT_TASK + TASK_COUNT,     // first of CLOCK_PROFILE_COUNT
+    // Debug only, compiled out at the default LOG_LEVEL, and only in LV
+    REPORT_CALIBRATION_THROTTLE1 = REPORT_CPU_LOAD + CLOCK_PROFILE_COUNT,
+    REPORT_CALIBRATION_THROTTLE2,
+    REPORT_CALIBRATION_BRAKE,
+    REPORT_STEPS
+} report_step_t;
+
+uint8_t report_step = REPORT_STEPS;     // REPORT_STEPS between reports
+uint32_t report_next_ms = 0;
+
+void send_report_step(uint8_t step) {
+    if (step >= REPORT_TASK && step < REPORT_CPU_LOAD) {
+        scheduler_print_stats(TASKS, task_stats, step - REPORT_TASK);
+        return;
+    }
+    if (step >= REPORT_CPU_LOAD && step < REPORT_CALIBRATION_THROTTLE1) {
+        LOG_INFO(CPU_LOAD, step - REPORT_CPU_LOAD, cpu_load[step - REPORT_CPU_LOAD].permille);
+        return;
+    }
+    
+    switch (step) {
+        case REPORT_TICK:
+            tick_print_stats();
+            break;
+        case REPORT_FSM:
+            LOG_INFO(FSM_STATS, fsm.transition_max_us);
+            break;
+        case REPORT_EVENTS:
+            LOG_INFO(EVENT_STATS, event_stats.dropped, event_stats.latency_max_us);
+            break;
+        case REPORT_UART:
+            LOG_INFO(UART_STATS, UART1_get_tx_sent(), UART1_get_tx_dropped(), UART1_get_tx_interrupts());
+            break;
+        case REPORT_TELEMETRY:
+            LOG_INFO(TELEMETRY_STATS, telemetry_stats.sent, telemetry_stats.dropped);
+            break;
+        case REPORT_CAN: {
+            can_tx_stats_t can_stats;
+            can_tx_get_stats(&can_stats);
+            LOG_INFO(CAN_STATS, can_stats.sent, can_stats.replaced, can_stats.dropped, can_stats.latency_max_us, CAN_isBusOff());
+            break;
+        }
+        case REPORT_INVERTER: {
+            inverter_status_t inverter;
+            can_rx_get_inverter(&inverter);
+            LOG_INFO(INVERTER_STATUS, inverter.vsm_state, inverter.dc_bus_dv, inverter.frames, inverter.overflows);
+            break;
+        }
+        case REPORT_TORQUE_CMD: {
+            torque_cmd_stats_t torque_stats;
+            torque_cmd_get_stats(&torque_stats);
+            LOG_INFO(TORQUE_CMD_STATS, torque_stats.sent, torque_stats.aborted, torque_stats.stale, torque_stats.over_budget, torque_stats.age_max_us);
+            break;
+        }
+        case REPORT_TORQUE_CMD_AGES: {
+            torque_cmd_stats_t torque_stats;
+            torque_cmd_get_stats(&torque_stats);
+            LOG_INFO(TORQUE_CMD_AGES, torque_stats.age_bins[0], torque_stats.age_bins[1], torque_stats.age_bins[2], torque_stats.age_bins[3], torque_stats.age_bins[4]);
+            break;
+        }
+        case REPORT_TORQUE_MAP:
+            LOG_INFO(TORQUE_MAP, torque_map_get_mode());
+            break;
+        case REPORT_CALIBRATION_THROTTLE1:
+            if (state == LV) {
+                LOG_DEBUG(CALIBRATION_THROTTLE1, throttle1, throttle1_min, throttle1_max);
+            }
+            break;
+        case REPORT_CALIBRATION_THROTTLE2:
+            if (state == LV) {
+                LOG_DEBUG(CALIBRATION_THROTTLE2, throttle2, throttle2_min, throttle2_max);
+            }
+            break;
+        case REPORT_CALIBRATION_BRAKE:
+            if (state == LV) {
+                LOG_DEBUG(CALIBRATION_BRAKE, brake, brake_min, brake_max);
+            }
+            break;
+    }
+}
+
+void run_housekeeping() {
+    if (report_step == REPORT_STEPS) {
+        // Signed difference so the comparison survives the ms counter wrapping
+        if ((int32_t)(tick_get_ms() - report_next_ms) < 0) {
+            return;
+        }
+        report_next_ms = tick_get_ms() + HOUSEKEEPING_REPORT_MS;
+        report_step = 0;
+        update_cpu_load();
+    }
+    
+    if (log_can_write()) {
+        send_report_step(report_step);
+        report_step++;
+    }
+}
+
 void main() {
     // Reset PIC18
     SYSTEM_Initialize();
+    clock_init();
 
     // Set up ADCC for reading analog signals
     ADCC_DischargeSampleCapacitor();
+    adc_scan_init();
+    init_sensor_thresholds();
+    can_tx_init();
+    can_rx_init();
+    torque_cmd_init();
+    
+    // Start the control tick
+    tick_init();
+    init_switches();
+    INTERRUPT_GlobalInterruptEnable();
 
     // Only for debugging. Use this to test the controls on the breadboard
     #if 0
@@ -265,161 +796,26 @@ void main() {
         printf("Brake : %d\r\n", brake);
         printf("HV switch: %d\r\n", is_hv_requested());
         printf("Drive switch: %d\r\n\n", is_drive_requested());
-        __delay_ms(1000);
+        tick_delay_ms(1000);
     }
     #endif
     
-    printf("Starting in %s state", STATE_NAMES[state]);
+    LOG_INFO(STARTUP, state);
     
     // TODO: set throttle and brake mins/maxs to opposite of range
     // see calibrating state in main() in pedal node
     
+    PROFILE_RESET();
+    fsm_init(&fsm, FSM_TABLE, ROW_LV, change_state);
+    scheduler_init(task_stats, TASK_COUNT);
+    cpu_load_start_us = tick_get_us();
+    tick_take_idle_us();
+    console_init(PARAMS, PARAM_COUNT);
+    
     while (1) {
-        // Main FSM
-        // Source: https://docs.google.com/document/d/1q0RL4FmDfVuAp6xp9yW7O-vIvnkwoAXWssC3-vBmNGM/edit?usp=sharing
-        
-        printf("-----------------------\r\n");
-        
-        switch (state) {
-            case LV:
-                run_calibration();
-                
-                if (is_drive_requested()) {
-                    // Drive switch should not be enabled during LV
-                    report_fault(DRIVE_REQUEST_FROM_LV);
-                    break;
-                }
-
-                if (is_hv_requested()) {
-                    // HV switch was flipped
-                    
-                    // Set throttle and brake range since calibration is done
-                    throttle_range = throttle1_max - throttle1_min;
-                    brake_range = brake_max - brake_min; // idk where this is even used
-                    
-                    // Start charging the car to high voltage state
-                    change_state(PRECHARGING);
-                } 
-                
-                break;
-            case PRECHARGING:
-                if (conservative_timer_ms >= MAX_CONSERVATION_SECS * 1000) {
-                    // Pre-charging took too long
-                    report_fault(CONSERVATIVE_TIMER_MAXED);
-                    break;
-                }
-                     
-                // TODO: get signal from motor controller
-                // that capacitor volts exceeded threshold
-                if (1) {
-                    // Finished charging to HV in timely manner
-                    change_state(HV_ENABLED);
-                    break;
-                }
-                
-                // TODO: check using clock cycles or system clock instead
-                // Check if pre-charge is finished for every delay
-                __delay_ms(AWAIT_PRECHARGING_DELAY_MS);
-                conservative_timer_ms += AWAIT_PRECHARGING_DELAY_MS;
-                break;
-            case HV_ENABLED:
-                update_sensor_vals();
-
-                if (!is_hv_requested()) {
-                    // Driver flipped off HV switch
-                    // TODO: or capacitor voltage went under threshold
-                    change_state(LV);
-                    break;
-                }
-                
-                if (is_drive_requested()) {
-                    // Driver flipped on drive switch
-                    // Need to press on pedal at the same time to go to drive
-                    if (brake >= PEDAL_MAX - BRAKE_ERROR_TOLERANCE) {
-
-                        change_state(DRIVE);                        
-                    } else {
-                        // Driver didn't press pedal
-                        report_fault(BRAKE_NOT_PRESSED);
-                    }
-                }
-                
-                break;
-            case DRIVE:
-                update_sensor_vals();
-
-                if (!is_drive_requested()) {
-                    // Drive switch was flipped off
-                    // Revert to HV
-                    change_state(HV_ENABLED);
-                   break;
-                }
-
-                if (!is_hv_requested()) {
-                    // HV switched flipped off, so can't drive
-                    report_fault(HV_DISABLED_WHILE_DRIVING);
-                    break;
-                }
-
-                if (brake_implausible()) {
-                    report_fault(BRAKE_IMPLAUSIBLE);
-                }
-                
-                break;
-            case FAULT:
-                switch (error) {
-                    case DRIVE_REQUEST_FROM_LV:
-                        if (!is_drive_requested()) {
-                            // Drive switch was flipped off
-                            // Revert to LV
-                            change_state(LV);
-                        }
-                        break;
-                    case CONSERVATIVE_TIMER_MAXED:
-                        if (!is_hv_requested() && !is_drive_requested()) {
-                            // Drive and HV switch must both be reset
-                            // to revert to LV
-                            change_state(LV);
-                        }
-                        break;
-                    case BRAKE_NOT_PRESSED:
-                        if (!is_drive_requested()) {
-                            // Ask driver to reset drive switch and try again
-                            change_state(HV_ENABLED);
-                        }
-                        break;
-                    case HV_DISABLED_WHILE_DRIVING:
-                        update_sensor_vals();
-
-                        if (!is_drive_requested()) {
-                            // Ask driver to flip off drive switch to properly go back to LV
-                            change_state(LV);
-                        }
-                        break;
-                    case SENSOR_DISCREPANCY:
-                        update_sensor_vals();
-                        
-                        // TODO: stop power to motors if discrepancy persists for >100ms
-                        // see rule T.4.2.5 in FSAE 2022 rulebook
-
-                        if (!has_discrepancy()) {
-                            // if discrepancy resolved, change back to previous state
-                            if (temp_state == FAULT) {
-                                report_fault(temp_error);
-                            } else {
-                                change_state(temp_state);
-                            }
-                        }
-                        break;
-                    case BRAKE_IMPLAUSIBLE:
-                        update_sensor_vals();
-
-                        if (!brake_implausible()) {
-                            change_state(DRIVE);
-                        }
-                }
-                break;
-        }
-        
+        // Run the due tasks once per tick so every rate stays fixed
+        // Ticks missed by overrunning tasks are counted in tick_stats
+        tick_wait();
+        scheduler_run(TASKS, task_stats, TASK_COUNT);
     }
 }
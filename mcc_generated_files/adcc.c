@@ -54,6 +54,8 @@
 /**
   Section: ADCC Module Variables
 */
+void (*ADCC_ADI_InterruptHandler)(void);
+void (*ADCC_ADTI_InterruptHandler)(void);
 
 /**
   Section: ADCC Module APIs
@@ -94,8 +96,8 @@ void ADCC_Initialize(void)
     ADCON1 = 0x00;
     // ADCRS 0; ADMD Basic_mode; ADACLR disabled; ADPSIS RES; 
     ADCON2 = 0x00;
-    // ADCALC First derivative of Single measurement; ADTMD disabled; ADSOI ADGO not cleared; 
-    ADCON3 = 0x00;
+    // ADCALC Filtered value vs setpoint; ADTMD always; ADSOI ADGO not cleared; 
+    ADCON3 = 0x57;
     // ADMATH registers not updated; 
     ADSTAT = 0x00;
     // ADNREF VSS; ADPREF VDD; 
@@ -107,6 +109,17 @@ void ADCC_Initialize(void)
     // ADGO stop; ADFM right; ADON enabled; ADCS Frc; ADCONT disabled; 
     ADCON0 = 0x94;
     
+    // Clear the ADC interrupt flag
+    PIR1bits.ADIF = 0;
+    // Disabling ADCC interrupt.
+    PIE1bits.ADIE = 0;
+    // Clear the ADC Threshold interrupt flag
+    PIR1bits.ADTIF = 0;
+    // Enabling ADCC threshold interrupt.
+    PIE1bits.ADTIE = 1;
+
+    ADCC_SetADIInterruptHandler(ADCC_DefaultInterruptHandler);
+    ADCC_SetADTIInterruptHandler(ADCC_DefaultThresholdInterruptHandler);
 
 }
 
@@ -296,6 +309,41 @@ uint8_t ADCC_GetConversionStageStatus(void)
     return ADSTATbits.ADSTAT;
 }
 
+void ADCC_ISR(void)
+{
+    // Clear the ADCC interrupt flag
+    PIR1bits.ADIF = 0;
+
+    if (ADCC_ADI_InterruptHandler)
+            ADCC_ADI_InterruptHandler();
+}
+
+void ADCC_SetADIInterruptHandler(void (* InterruptHandler)(void)){
+    ADCC_ADI_InterruptHandler = InterruptHandler;
+}
+
+void ADCC_DefaultInterruptHandler(void){
+    // add your ADCC interrupt custom code
+    // or set custom function using ADCC_SetADIInterruptHandler() or ADCC_SetADTIInterruptHandler()
+}
+
+void ADCC_ThresholdISR(void)
+{
+    // Clear the ADCC Threshold interrupt flag
+    PIR1bits.ADTIF = 0;
+
+    if (ADCC_ADTI_InterruptHandler)
+        ADCC_ADTI_InterruptHandler();
+}
+
+void ADCC_SetADTIInterruptHandler(void (* InterruptHandler)(void)){
+    ADCC_ADTI_InterruptHandler = InterruptHandler;
+}
+
+void ADCC_DefaultThresholdInterruptHandler(void){
+    // add your ADCC threshold interrupt handler code
+}
+
 
 /**
  End of File
@@ -90,6 +90,7 @@ typedef enum
 {
     channel_ANB0 =  0x8,
     channel_ANB1 =  0x9,
+    channel_ANB5 =  0xD,
     channel_VSS =  0x3B,
     channel_Temp =  0x3C,
     channel_DAC1 =  0x3D,
@@ -828,6 +829,115 @@ bool ADCC_HasErrorCrossedLowerThreshold(void);
 */
 uint8_t ADCC_GetConversionStageStatus(void);
 
+/**
+  @Summary
+    Implements ISR
+
+  @Description
+    This routine is used to implement the ISR for the interrupt-driven
+    implementations.
+
+  @Returns
+    None
+
+  @Param
+    None
+*/
+void ADCC_ISR(void);
+
+/**
+  @Summary
+    Sets the ADCC interrupt handler.
+
+  @Description
+    This routine is used to set the ADCC interrupt handler which is called
+    on completion of every conversion.
+
+  @Preconditions
+    ADCC_Initialize() function should have been called before calling this function.
+
+  @Returns
+    None
+
+  @Param
+    Address of function to be set
+
+  @Example
+    <code>
+    ADCC_SetADIInterruptHandler(MyInterruptHandler);
+    </code>
+*/
+void ADCC_SetADIInterruptHandler(void (* InterruptHandler)(void));
+
+/**
+  @Summary
+    Default ADCC interrupt handler.
+
+  @Description
+    This is the default handler set by ADCC_Initialize().
+
+  @Returns
+    None
+
+  @Param
+    None
+*/
+void ADCC_DefaultInterruptHandler(void);
+
+/**
+  @Summary
+    Implements threshold ISR
+
+  @Description
+    This routine is used to implement the ISR for the threshold interrupt,
+    raised once the computation at the end of a conversion (or burst) is done.
+
+  @Returns
+    None
+
+  @Param
+    None
+*/
+void ADCC_ThresholdISR(void);
+
+/**
+  @Summary
+    Sets the ADCC threshold interrupt handler.
+
+  @Description
+    This routine is used to set the ADCC threshold interrupt handler.
+
+  @Preconditions
+    ADCC_Initialize() function should have been called before calling this function.
+
+  @Returns
+    None
+
+  @Param
+    Address of function to be set
+
+  @Example
+    <code>
+    ADCC_SetADTIInterruptHandler(MyInterruptHandler);
+    </code>
+*/
+void ADCC_SetADTIInterruptHandler(void (* InterruptHandler)(void));
+
+/**
+  @Summary
+    Default ADCC threshold interrupt handler.
+
+  @Description
+    This is the default threshold handler set by ADCC_Initialize().
+
+  @Returns
+    None
+
+  @Param
+    None
+*/
+void ADCC_DefaultThresholdInterruptHandler(void);
+
 
 
 
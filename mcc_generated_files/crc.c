@@ -0,0 +1,134 @@
+/**
+  CRC Generated Driver File
+
+  @Company
+    Microchip Technology Inc.
+
+  @File Name
+    crc.c
+
+  @Summary
+    This is the generated driver implementation file for the CRC driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description
+    This source file provides APIs for driver for CRC.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F26K83
+        Driver Version    :  2.0.1
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above
+        MPLAB             :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+/**
+  Section: Included Files
+*/
+
+#include <xc.h>
+#include "crc.h"
+
+/**
+  Section: CRC Module APIs
+*/
+
+static uint16_t CRC_ReverseValue(uint16_t value);
+
+void CRC_Initialize(void)
+{
+    // CRCACC 0; 
+    CRCACCH = 0x00;
+    CRCACCL = 0x00;
+
+    // CRCXOR 4129; polynomial x^16+x^12+x^5+1
+    CRCXORH = 0x10;
+    CRCXORL = 0x21;
+
+    // DLEN 7; PLEN 15; 
+    CRCCON1 = 0x7F;
+
+    // EN enabled; GO disabled; ACCM data augmented with 0's; SHIFTM shift left; 
+    // EN is bit 7 and ACCM bit 4 (bits 3-2 are unimplemented)
+    CRCCON0 = 0x90;
+}
+
+void CRC_SeedSet(uint16_t seed)
+{
+    CRCACCH = (uint8_t) (seed >> 8);
+    CRCACCL = (uint8_t) seed;
+}
+
+void CRC_StartCrc(void)
+{
+    // Start the serial shifter
+    CRCCON0bits.GO = 1;
+}
+
+bool CRC_8BitDataWrite(uint8_t data)
+{
+    if(!CRCCON0bits.FULL)
+    {
+        CRCDATL = data;
+        return true;
+    }
+    return false;
+}
+
+bool CRC_IsCrcBusy(void)
+{
+    return CRCCON0bits.BUSY;
+}
+
+uint16_t CRC_CalculatedResultGet(bool reverse, uint16_t xorValue)
+{
+    uint16_t result;
+
+    CRCCON0bits.GO = 0;
+    result = (uint16_t) ((CRCACCH << 8) | CRCACCL);
+
+    if(reverse)
+    {
+        result = CRC_ReverseValue(result);
+    }
+
+    return (result ^ xorValue);
+}
+
+static uint16_t CRC_ReverseValue(uint16_t value)
+{
+    uint16_t reversed = 0;
+    uint8_t i;
+
+    for(i = 0; i < 16; i++)
+    {
+        reversed = (uint16_t) ((reversed << 1) | (value & 1));
+        value >>= 1;
+    }
+    return reversed;
+}
+/**
+ End of File
+*/
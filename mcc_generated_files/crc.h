@@ -0,0 +1,198 @@
+/**
+  CRC Generated Driver API Header File
+
+  @Company
+    Microchip Technology Inc.
+
+  @File Name
+    crc.h
+
+  @Summary
+    This is the generated header file for the CRC driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description
+    This header file provides APIs for driver for CRC.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F26K83
+        Driver Version    :  2.0.1
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above
+        MPLAB             :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+#ifndef CRC_H
+#define CRC_H
+
+/**
+  Section: Included Files
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+
+/**
+  Section: CRC APIs
+*/
+
+/**
+  @Summary
+    Initializes the CRC module.
+
+  @Description
+    This function initializes the CRC module for CRC-16-CCITT
+    (polynomial 0x1021, MSb first, 8-bit data, augmented with zeros so the
+    result needs no trailing bytes).
+    This function must be called before any other CRC function is called.
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    None
+
+  @Example
+    <code>
+    CRC_Initialize();
+    </code>
+*/
+void CRC_Initialize(void);
+
+/**
+  @Summary
+    Loads the CRC accumulator with a seed value.
+
+  @Description
+    This function writes the seed value to the CRCACC registers.
+    It must be called before CRC_StartCrc() for every new calculation.
+
+  @Preconditions
+    Initialize  the CRC module before calling this function.
+
+  @Param
+    seed - Initial value of the accumulator, e.g. 0xFFFF
+
+  @Returns
+    None
+*/
+void CRC_SeedSet(uint16_t seed);
+
+/**
+  @Summary
+    Starts the CRC module.
+
+  @Description
+    This function sets the GO bit so the module computes on every byte
+    written to CRCDATL.
+
+  @Preconditions
+    Initialize  the CRC module and set the seed before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void CRC_StartCrc(void);
+
+/**
+  @Summary
+    Writes one byte of data to the CRC module.
+
+  @Description
+    This function writes the byte to CRCDATL if the data buffer is not full.
+
+  @Preconditions
+    Start the CRC module before calling this function.
+
+  @Param
+    data - Byte to add to the calculation
+
+  @Returns
+    true  - The byte was accepted
+    false - The data buffer is full; write it again
+*/
+bool CRC_8BitDataWrite(uint8_t data);
+
+/**
+  @Summary
+    Returns whether the CRC module is still shifting data.
+
+  @Description
+    This function returns the value of the BUSY bit.
+
+  @Preconditions
+    Start the CRC module before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    true  - The module is still computing
+    false - The result in CRCACC is final
+*/
+bool CRC_IsCrcBusy(void);
+
+/**
+  @Summary
+    Returns the calculated CRC result.
+
+  @Description
+    This function stops the module and reads CRCACC, optionally bit
+    reversed, and XORed with xorValue.
+
+  @Preconditions
+    CRC_IsCrcBusy() should return false before calling this function.
+
+  @Param
+    reverse  - Bit reverse the result
+    xorValue - Value the result is XORed with (0 for none)
+
+  @Returns
+    The CRC of every byte written since CRC_StartCrc()
+*/
+uint16_t CRC_CalculatedResultGet(bool reverse, uint16_t xorValue);
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+
+#endif // CRC_H
+/**
+ End of File
+*/
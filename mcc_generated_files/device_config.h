@@ -47,7 +47,8 @@
 #ifndef DEVICE_CONFIG_H
 #define	DEVICE_CONFIG_H
 
-#define _XTAL_FREQ 1000000
+// Clock at reset; clock.c can change it at runtime
+#define _XTAL_FREQ 8000000
 
 #endif	/* DEVICE_CONFIG_H */
 /**
@@ -0,0 +1,150 @@
+/**
+  DMA1 Generated Driver File
+
+  @Company
+    Microchip Technology Inc.
+
+  @File Name
+    dma1.c
+
+  @Summary
+    This is the generated driver implementation file for the DMA1 driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description
+    This source file provides APIs for DMA1.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F26K83
+        Driver Version    :  2.10
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above
+        MPLAB             :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+/**
+  Section: Included Files
+*/
+
+#include <xc.h>
+#include "dma1.h"
+
+void (*DMA1_DCNTI_InterruptHandler)(void);
+
+/**
+  Section: DMA1 APIs
+*/
+
+void DMA1_Initialize(void)
+{
+    // EN disabled; SIRQEN disabled; DGO not in progress; AIRQEN disabled; 
+    DMA1CON0 = 0x00;
+
+    // DMODE incremented; DSTP set; SMR SFR/GPR; SMODE incremented; SSTP not cleared; 
+    DMA1CON1 = 0x62;
+
+    // AIRQ none; 
+    DMA1AIRQ = 0x00;
+
+    // Clear Destination Count Interrupt Flag bit
+    PIR2bits.DMA1DCNTIF = 0;
+    // Clear Source Count Interrupt Flag bit
+    PIR2bits.DMA1SCNTIF = 0;
+    // Clear Abort Interrupt Flag bit
+    PIR2bits.DMA1AIF = 0;
+    // Clear Overrun Interrupt Flag bit
+    PIR2bits.DMA1ORIF = 0;
+
+    // Enable Destination Count Interrupt
+    PIE2bits.DMA1DCNTIE = 1;
+    DMA1_SetDMADestCountInterruptHandler(DMA1_DefaultInterruptHandler);
+
+    // EN enabled; SIRQEN disabled; DGO not in progress; AIRQEN disabled; 
+    DMA1CON0 = 0x80;
+}
+
+void DMA1_SetSourceAddress(uint24_t address)
+{
+    DMA1SSAU = (uint8_t) (address >> 16);
+    DMA1SSAH = (uint8_t) (address >> 8);
+    DMA1SSAL = (uint8_t) address;
+}
+
+void DMA1_SetDestinationAddress(uint16_t address)
+{
+    DMA1DSAH = (uint8_t) (address >> 8);
+    DMA1DSAL = (uint8_t) address;
+}
+
+void DMA1_SetSourceSize(uint16_t size)
+{
+    DMA1SSZH = (uint8_t) (size >> 8);
+    DMA1SSZL = (uint8_t) size;
+}
+
+void DMA1_SetDestinationSize(uint16_t size)
+{
+    DMA1DSZH = (uint8_t) (size >> 8);
+    DMA1DSZL = (uint8_t) size;
+}
+
+void DMA1_SetStartTrigger(uint8_t sirq)
+{
+    DMA1SIRQ = sirq;
+}
+
+void DMA1_StartTransferWithTrigger(void)
+{
+    DMA1CON0bits.SIRQEN = 1;
+}
+
+void DMA1_StopTransfer(void)
+{
+    DMA1CON0bits.SIRQEN = 0;
+    DMA1CON0bits.DGO = 0;
+}
+
+void DMA1_DMADCNTI_ISR(void)
+{
+    // Clear the destination count interrupt flag
+    PIR2bits.DMA1DCNTIF = 0;
+
+    if (DMA1_DCNTI_InterruptHandler)
+        DMA1_DCNTI_InterruptHandler();
+}
+
+void DMA1_SetDMADestCountInterruptHandler(void (* InterruptHandler)(void))
+{
+    DMA1_DCNTI_InterruptHandler = InterruptHandler;
+}
+
+void DMA1_DefaultInterruptHandler(void)
+{
+    // add your DMA1 interrupt custom code
+    // or set custom function using DMA1_SetDMADestCountInterruptHandler()
+}
+/**
+ End of File
+*/
@@ -0,0 +1,150 @@
+/**
+  DMA2 Generated Driver File
+
+  @Company
+    Microchip Technology Inc.
+
+  @File Name
+    dma2.c
+
+  @Summary
+    This is the generated driver implementation file for the DMA2 driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description
+    This source file provides APIs for DMA2.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F26K83
+        Driver Version    :  2.10
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above
+        MPLAB             :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+/**
+  Section: Included Files
+*/
+
+#include <xc.h>
+#include "dma2.h"
+
+void (*DMA2_SCNTI_InterruptHandler)(void);
+
+/**
+  Section: DMA2 APIs
+*/
+
+void DMA2_Initialize(void)
+{
+    // EN disabled; SIRQEN disabled; DGO not in progress; AIRQEN disabled; 
+    DMA2CON0 = 0x00;
+
+    // DMODE unchanged; DSTP not cleared; SMR SFR/GPR; SMODE incremented; SSTP set; 
+    DMA2CON1 = 0x03;
+
+    // AIRQ none; 
+    DMA2AIRQ = 0x00;
+
+    // Clear Destination Count Interrupt Flag bit
+    PIR10bits.DMA2DCNTIF = 0;
+    // Clear Source Count Interrupt Flag bit
+    PIR10bits.DMA2SCNTIF = 0;
+    // Clear Abort Interrupt Flag bit
+    PIR10bits.DMA2AIF = 0;
+    // Clear Overrun Interrupt Flag bit
+    PIR10bits.DMA2ORIF = 0;
+
+    // Enable Source Count Interrupt
+    PIE10bits.DMA2SCNTIE = 1;
+    DMA2_SetDMASourceCountInterruptHandler(DMA2_DefaultInterruptHandler);
+
+    // EN enabled; SIRQEN disabled; DGO not in progress; AIRQEN disabled; 
+    DMA2CON0 = 0x80;
+}
+
+void DMA2_SetSourceAddress(uint24_t address)
+{
+    DMA2SSAU = (uint8_t) (address >> 16);
+    DMA2SSAH = (uint8_t) (address >> 8);
+    DMA2SSAL = (uint8_t) address;
+}
+
+void DMA2_SetDestinationAddress(uint16_t address)
+{
+    DMA2DSAH = (uint8_t) (address >> 8);
+    DMA2DSAL = (uint8_t) address;
+}
+
+void DMA2_SetSourceSize(uint16_t size)
+{
+    DMA2SSZH = (uint8_t) (size >> 8);
+    DMA2SSZL = (uint8_t) size;
+}
+
+void DMA2_SetDestinationSize(uint16_t size)
+{
+    DMA2DSZH = (uint8_t) (size >> 8);
+    DMA2DSZL = (uint8_t) size;
+}
+
+void DMA2_SetStartTrigger(uint8_t sirq)
+{
+    DMA2SIRQ = sirq;
+}
+
+void DMA2_StartTransferWithTrigger(void)
+{
+    DMA2CON0bits.SIRQEN = 1;
+}
+
+void DMA2_StopTransfer(void)
+{
+    DMA2CON0bits.SIRQEN = 0;
+    DMA2CON0bits.DGO = 0;
+}
+
+void DMA2_DMASCNTI_ISR(void)
+{
+    // Clear the source count interrupt flag
+    PIR10bits.DMA2SCNTIF = 0;
+
+    if (DMA2_SCNTI_InterruptHandler)
+        DMA2_SCNTI_InterruptHandler();
+}
+
+void DMA2_SetDMASourceCountInterruptHandler(void (* InterruptHandler)(void))
+{
+    DMA2_SCNTI_InterruptHandler = InterruptHandler;
+}
+
+void DMA2_DefaultInterruptHandler(void)
+{
+    // add your DMA2 interrupt custom code
+    // or set custom function using DMA2_SetDMASourceCountInterruptHandler()
+}
+/**
+ End of File
+*/
@@ -0,0 +1,217 @@
+/**
+  DMA2 Generated Driver API Header File
+
+  @Company
+    Microchip Technology Inc.
+
+  @File Name
+    dma2.h
+
+  @Summary
+    This is the generated header file for the DMA2 driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description
+    This header file provides APIs for driver for DMA2.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F26K83
+        Driver Version    :  2.10
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above
+        MPLAB             :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+#ifndef DMA2_H
+#define DMA2_H
+
+/**
+  Section: Included Files
+*/
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+
+/**
+  Section: DMA2 APIs
+*/
+
+/**
+  @Summary
+    Initializes the DMA2
+
+  @Description
+    This routine initializes the DMA2 and must be called before any other DMA2 routine.
+    Addresses, sizes and the start trigger are left for the application to
+    set because they point at application buffers.
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void DMA2_Initialize(void);
+
+/**
+  @Summary
+    Sets the source start address.
+
+  @Param
+    address - 22-bit source address
+
+  @Returns
+    None
+*/
+void DMA2_SetSourceAddress(uint24_t address);
+
+/**
+  @Summary
+    Sets the destination start address.
+
+  @Param
+    address - 12-bit destination address in data memory
+
+  @Returns
+    None
+*/
+void DMA2_SetDestinationAddress(uint16_t address);
+
+/**
+  @Summary
+    Sets the source size in bytes.
+
+  @Param
+    size - number of bytes
+
+  @Returns
+    None
+*/
+void DMA2_SetSourceSize(uint16_t size);
+
+/**
+  @Summary
+    Sets the destination size in bytes.
+
+  @Param
+    size - number of bytes
+
+  @Returns
+    None
+*/
+void DMA2_SetDestinationSize(uint16_t size);
+
+/**
+  @Summary
+    Sets the interrupt source that starts a transfer.
+
+  @Param
+    sirq - interrupt vector number of the trigger source
+
+  @Returns
+    None
+*/
+void DMA2_SetStartTrigger(uint8_t sirq);
+
+/**
+  @Summary
+    Arms the DMA2 so the next start trigger begins a transfer.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void DMA2_StartTransferWithTrigger(void);
+
+/**
+  @Summary
+    Stops any transfer in progress and disarms the trigger.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void DMA2_StopTransfer(void);
+
+/**
+  @Summary
+    Source count interrupt service routine, called by the Interrupt Manager.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void DMA2_DMASCNTI_ISR(void);
+
+/**
+  @Summary
+    Sets the source count interrupt handler.
+
+  @Param
+    Address of function to be set
+
+  @Returns
+    None
+*/
+void DMA2_SetDMASourceCountInterruptHandler(void (* InterruptHandler)(void));
+
+/**
+  @Summary
+    Default source count interrupt handler.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void DMA2_DefaultInterruptHandler(void);
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+
+#endif //DMA2_H
+/**
+ End of File
+*/
@@ -0,0 +1,533 @@
+/**
+  ECAN Generated Driver File
+
+  @Company
+    Microchip Technology Inc.
+
+  @File Name
+    ecan.c
+
+  @Summary
+    This is the generated driver implementation file for the ECAN driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description
+    This source file provides APIs for ECAN.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F26K83
+        Driver Version    :  2.12.0
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above
+        MPLAB             :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+/**
+  Section: Included Files
+*/
+
+#include <xc.h>
+#include "ecan.h"
+
+// TXBnCON, TXBnSIDH, TXBnSIDL, TXBnEIDH, TXBnEIDL, TXBnDLC and TXBnD0-D7
+// are consecutive SFRs, the same in every TX buffer
+#define TXB_SIDH 1
+#define TXB_SIDL 2
+#define TXB_EIDH 3
+#define TXB_EIDL 4
+#define TXB_DLC  5
+#define TXB_D0   6
+
+static void (*ECAN_TXBnInterruptHandlers[ECAN_TX_BUFFER_COUNT])(uint8_t buffer);
+void (*ECAN_RXBnInterruptHandler)(void);
+
+static volatile uint8_t* const txBuffers[ECAN_TX_BUFFER_COUNT] = { &TXB0CON, &TXB1CON, &TXB2CON };
+
+static uint32_t convertReg2ExtendedCANid(uint8_t tempRXBn_EIDH, uint8_t tempRXBn_EIDL, uint8_t tempRXBn_SIDH, uint8_t tempRXBn_SIDL);
+static uint32_t convertReg2StandardCANid(uint8_t tempRXBn_SIDH, uint8_t tempRXBn_SIDL);
+static void convertCANid2Reg(uint32_t tempPassedInID, uint8_t canIdType, uint8_t *passedInEIDH, uint8_t *passedInEIDL, uint8_t *passedInSIDH, uint8_t *passedInSIDL);
+
+void ECAN_Initialize(void)
+{
+    ECAN_SetOperationMode(ECAN_CONFIGURATION_MODE);
+
+    /**
+    Mode 0
+    */
+    // MDSEL Legacy mode; FIFOWM 4 remaining; EWIN RXB0; 
+    ECANCON = 0x00;
+
+    /**
+    Initialize CAN I/O
+    */
+    // CLKSEL system clock; CANCAP disabled; ENDRHI recessive; 
+    CIOCON = 0x20;
+
+    /**
+    Mask and Filter definitions
+    Only the motor controller's voltage and state messages (see can_rx.h)
+    are accepted; every other ID is dropped by the hardware
+    ........................................................
+    CAN ID      ID Type     Mask                Filter      Buffer
+    ........................................................
+    0x0A7       SID         0x7FF               RXF0        RXB0
+    0x0AA       SID         0x7FF               RXF1        RXB0
+    0x0A7       SID         0x7FF               RXF2, RXF4  RXB1
+    0x0AA       SID         0x7FF               RXF3, RXF5  RXB1
+    ........................................................
+    */
+
+    /**
+    Initialize Receive Masks
+    */
+    RXM0EIDH = 0x00;
+    RXM0EIDL = 0x00;
+    RXM0SIDH = 0xFF;
+    RXM0SIDL = 0xE0;
+    RXM1EIDH = 0x00;
+    RXM1EIDL = 0x00;
+    RXM1SIDH = 0xFF;
+    RXM1SIDL = 0xE0;
+
+    /**
+    Initialize Receive Filters
+    */
+    RXF0EIDH = 0x00;
+    RXF0EIDL = 0x00;
+    RXF0SIDH = 0x14;
+    RXF0SIDL = 0xE0;
+    RXF1EIDH = 0x00;
+    RXF1EIDL = 0x00;
+    RXF1SIDH = 0x15;
+    RXF1SIDL = 0x40;
+    RXF2EIDH = 0x00;
+    RXF2EIDL = 0x00;
+    RXF2SIDH = 0x14;
+    RXF2SIDL = 0xE0;
+    RXF3EIDH = 0x00;
+    RXF3EIDL = 0x00;
+    RXF3SIDH = 0x15;
+    RXF3SIDL = 0x40;
+    RXF4EIDH = 0x00;
+    RXF4EIDL = 0x00;
+    RXF4SIDH = 0x14;
+    RXF4SIDL = 0xE0;
+    RXF5EIDH = 0x00;
+    RXF5EIDL = 0x00;
+    RXF5SIDH = 0x15;
+    RXF5SIDL = 0x40;
+
+    // RXM receive valid messages per filters; RXB0DBEN overflow to RXB1; 
+    RXB0CON = 0x04;
+    // RXM receive valid messages per filters; 
+    RXB1CON = 0x00;
+
+    /**
+    Initialize CAN Timings
+    */
+
+    /**
+    Baud rate: 500kbps
+    System frequency: 8000000
+    ECAN clock frequency: 8000000
+    Time quanta: 8
+    Sample point: 1-1-4-2
+    Sample point: 75%
+    */
+
+    // SJW 1 x TQ; BRP 0; 
+    BRGCON1 = 0x00;
+    // SEG2PHTS freely programmable; SAM once; SEG1PH 4 x TQ; PRSEG 1 x TQ; 
+    BRGCON2 = 0x98;
+    // WAKDIS enabled; WAKFIL disabled; SEG2PH 2 x TQ; 
+    BRGCON3 = 0x01;
+
+    ECAN_SetTXBnInterruptHandler(0, ECAN_DefaultTXBnInterruptHandler);
+    ECAN_SetTXBnInterruptHandler(1, ECAN_DefaultTXBnInterruptHandler);
+    ECAN_SetTXBnInterruptHandler(2, ECAN_DefaultTXBnInterruptHandler);
+    ECAN_SetRXBnInterruptHandler(ECAN_DefaultRXBnInterruptHandler);
+
+    // Clear and enable the RX buffer interrupts
+    PIR5bits.RXB0IF = 0;
+    PIR5bits.RXB1IF = 0;
+    PIE5bits.RXB0IE = 1;
+    PIE5bits.RXB1IE = 1;
+
+    // Clear and enable the TX buffer interrupts
+    PIR5bits.TXB0IF = 0;
+    PIR5bits.TXB1IF = 0;
+    PIR5bits.TXB2IF = 0;
+    PIE5bits.TXB0IE = 1;
+    PIE5bits.TXB1IE = 1;
+    PIE5bits.TXB2IE = 1;
+
+#if ECAN_LOOPBACK
+    ECAN_SetOperationMode(ECAN_LOOPBACK_MODE);
+#else
+    ECAN_SetOperationMode(ECAN_NORMAL_MODE);
+#endif
+}
+
+void ECAN_SetOperationMode(ECAN_OP_MODES mode)
+{
+    CANCON = (uint8_t) mode;
+    while ((uint8_t) mode != (CANSTAT & 0xE0))
+    {
+        // wait until ECAN is in the requested mode
+    }
+}
+
+ECAN_OP_MODES ECAN_GetOperationMode(void)
+{
+    return (ECAN_OP_MODES) (CANSTAT & 0xE0);
+}
+
+void ECAN_SetTXBnPriority(uint8_t buffer, uint8_t priority)
+{
+    // TXPRI
+    *txBuffers[buffer] = (uint8_t) ((*txBuffers[buffer] & 0xFC) | (priority & 0x03));
+}
+
+void ECAN_SetBaudRatePrescaler(uint8_t brp)
+{
+    // Keep SJW
+    BRGCON1 = (uint8_t) ((BRGCON1 & 0xC0) | (brp & 0x3F));
+}
+
+uint8_t CAN_transmitBuffer(uint8_t buffer, uCAN_MSG *tempCanMsg)
+{
+    volatile uint8_t* txb = txBuffers[buffer];
+    uint8_t tempEIDH = 0;
+    uint8_t tempEIDL = 0;
+    uint8_t tempSIDH = 0;
+    uint8_t tempSIDL = 0;
+
+    // TXREQ
+    if (txb[0] & 0x08)
+    {
+        return 0;
+    }
+
+    convertCANid2Reg(tempCanMsg->frame.id, tempCanMsg->frame.idType, &tempEIDH, &tempEIDL, &tempSIDH, &tempSIDL);
+
+    txb[TXB_EIDH] = tempEIDH;
+    txb[TXB_EIDL] = tempEIDL;
+    txb[TXB_SIDH] = tempSIDH;
+    txb[TXB_SIDL] = tempSIDL;
+    txb[TXB_DLC] = tempCanMsg->frame.dlc;
+    txb[TXB_D0 + 0] = tempCanMsg->frame.data0;
+    txb[TXB_D0 + 1] = tempCanMsg->frame.data1;
+    txb[TXB_D0 + 2] = tempCanMsg->frame.data2;
+    txb[TXB_D0 + 3] = tempCanMsg->frame.data3;
+    txb[TXB_D0 + 4] = tempCanMsg->frame.data4;
+    txb[TXB_D0 + 5] = tempCanMsg->frame.data5;
+    txb[TXB_D0 + 6] = tempCanMsg->frame.data6;
+    txb[TXB_D0 + 7] = tempCanMsg->frame.data7;
+
+    // Set the buffer to transmit
+    txb[0] |= 0x08;
+    return 1;
+}
+
+uint8_t CAN_isTXBufferPending(uint8_t buffer)
+{
+    // TXREQ
+    return (uint8_t) ((*txBuffers[buffer] & 0x08) != 0);
+}
+
+void CAN_abortTransmitBuffer(uint8_t buffer)
+{
+    // TXREQ
+    *txBuffers[buffer] &= (uint8_t) ~0x08;
+}
+
+uint8_t CAN_transmit(uCAN_MSG *tempCanMsg)
+{
+    for (uint8_t buffer = 0; buffer < ECAN_TX_BUFFER_COUNT; buffer++)
+    {
+        if (CAN_transmitBuffer(buffer, tempCanMsg))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+uint8_t CAN_receive(uCAN_MSG *tempCanMsg)
+{
+    uint8_t returnValue = 0;
+
+    //check which buffer the CAN message is in
+    if (RXB0CONbits.RXFUL != 0) //CheckRXB0
+    {
+        if ((RXB0SIDL & 0x08) == 0x08) //If Extended Message
+        {
+            //message is extended
+            tempCanMsg->frame.idType = (uint8_t) dEXTENDED_CAN_MSG_ID_2_0B;
+            tempCanMsg->frame.id = convertReg2ExtendedCANid(RXB0EIDH, RXB0EIDL, RXB0SIDH, RXB0SIDL);
+        }
+        else
+        {
+            //message is standard
+            tempCanMsg->frame.idType = (uint8_t) dSTANDARD_CAN_MSG_ID_2_0B;
+            tempCanMsg->frame.id = convertReg2StandardCANid(RXB0SIDH, RXB0SIDL);
+        }
+
+        tempCanMsg->frame.dlc   = RXB0DLC;
+        tempCanMsg->frame.data0 = RXB0D0;
+        tempCanMsg->frame.data1 = RXB0D1;
+        tempCanMsg->frame.data2 = RXB0D2;
+        tempCanMsg->frame.data3 = RXB0D3;
+        tempCanMsg->frame.data4 = RXB0D4;
+        tempCanMsg->frame.data5 = RXB0D5;
+        tempCanMsg->frame.data6 = RXB0D6;
+        tempCanMsg->frame.data7 = RXB0D7;
+        RXB0CONbits.RXFUL = 0;
+        returnValue = 1;
+    }
+    else if (RXB1CONbits.RXFUL != 0) //CheckRXB1
+    {
+        if ((RXB1SIDL & 0x08) == 0x08) //If Extended Message
+        {
+            //message is extended
+            tempCanMsg->frame.idType = (uint8_t) dEXTENDED_CAN_MSG_ID_2_0B;
+            tempCanMsg->frame.id = convertReg2ExtendedCANid(RXB1EIDH, RXB1EIDL, RXB1SIDH, RXB1SIDL);
+        }
+        else
+        {
+            //message is standard
+            tempCanMsg->frame.idType = (uint8_t) dSTANDARD_CAN_MSG_ID_2_0B;
+            tempCanMsg->frame.id = convertReg2StandardCANid(RXB1SIDH, RXB1SIDL);
+        }
+
+        tempCanMsg->frame.dlc   = RXB1DLC;
+        tempCanMsg->frame.data0 = RXB1D0;
+        tempCanMsg->frame.data1 = RXB1D1;
+        tempCanMsg->frame.data2 = RXB1D2;
+        tempCanMsg->frame.data3 = RXB1D3;
+        tempCanMsg->frame.data4 = RXB1D4;
+        tempCanMsg->frame.data5 = RXB1D5;
+        tempCanMsg->frame.data6 = RXB1D6;
+        tempCanMsg->frame.data7 = RXB1D7;
+        RXB1CONbits.RXFUL = 0;
+        returnValue = 1;
+    }
+    return (returnValue);
+}
+
+uint8_t CAN_messagesInBuffer(void)
+{
+    uint8_t messageCount = 0;
+    if (RXB0CONbits.RXFUL != 0) //CheckRXB0
+    {
+        messageCount++;
+    }
+    if (RXB1CONbits.RXFUL != 0) //CheckRXB1
+    {
+        messageCount++;
+    }
+
+    return (messageCount);
+}
+
+uint8_t CAN_hasRXOverflowed(void)
+{
+    uint8_t returnValue = 0;
+
+    //COMSTAT bits 7 and 6 RXBnOVFL: Receive Buffer Overflow bits
+    if (COMSTATbits.RXB0OVFL == 1 || COMSTATbits.RXB1OVFL == 1)
+    {
+        COMSTATbits.RXB0OVFL = 0;
+        COMSTATbits.RXB1OVFL = 0;
+        returnValue = 1;
+    }
+    return (returnValue);
+}
+
+uint8_t CAN_isBusOff(void)
+{
+    uint8_t returnValue = 0;
+
+    //COMSTAT bit 5 TXBO: Transmitter Bus-Off bit
+    if (COMSTATbits.TXBO == 1)
+    {
+        returnValue = 1;
+    }
+    return (returnValue);
+}
+
+uint8_t CAN_isRXErrorPassive(void)
+{
+    uint8_t returnValue = 0;
+
+    //COMSTAT bit 3 RXBP: Receiver Bus Passive bit
+    if (COMSTATbits.RXBP == 1)
+    {
+        returnValue = 1;
+    }
+    return (returnValue);
+}
+
+uint8_t CAN_isTXErrorPassive(void)
+{
+    uint8_t returnValue = 0;
+
+    //COMSTAT bit 4 TXBP: Transmitter Bus Passive bit
+    if (COMSTATbits.TXBP == 1)
+    {
+        returnValue = 1;
+    }
+    return (returnValue);
+}
+
+void ECAN_TXBnI_ISR(void)
+{
+    if (PIR5bits.TXB0IF == 1)
+    {
+        PIR5bits.TXB0IF = 0;
+        ECAN_TXBnInterruptHandlers[0](0);
+    }
+    if (PIR5bits.TXB1IF == 1)
+    {
+        PIR5bits.TXB1IF = 0;
+        ECAN_TXBnInterruptHandlers[1](1);
+    }
+    if (PIR5bits.TXB2IF == 1)
+    {
+        PIR5bits.TXB2IF = 0;
+        ECAN_TXBnInterruptHandlers[2](2);
+    }
+}
+
+void ECAN_SetTXBnInterruptHandler(uint8_t buffer, void (* InterruptHandler)(uint8_t buffer))
+{
+    ECAN_TXBnInterruptHandlers[buffer] = InterruptHandler;
+}
+
+void ECAN_DefaultTXBnInterruptHandler(uint8_t buffer)
+{
+    // add your ECAN TX buffer interrupt custom code
+    // or set custom function using ECAN_SetTXBnInterruptHandler()
+}
+
+void ECAN_RXBnI_ISR(void)
+{
+    PIR5bits.RXB0IF = 0;
+    PIR5bits.RXB1IF = 0;
+    ECAN_RXBnInterruptHandler();
+}
+
+void ECAN_SetRXBnInterruptHandler(void (* InterruptHandler)(void))
+{
+    ECAN_RXBnInterruptHandler = InterruptHandler;
+}
+
+void ECAN_DefaultRXBnInterruptHandler(void)
+{
+    uCAN_MSG msg;
+
+    // add your ECAN RX buffer interrupt custom code
+    // or set custom function using ECAN_SetRXBnInterruptHandler()
+
+    // Free the buffers so reception continues
+    while (CAN_receive(&msg))
+    {
+    }
+}
+
+static uint32_t convertReg2ExtendedCANid(uint8_t tempRXBn_EIDH, uint8_t tempRXBn_EIDL, uint8_t tempRXBn_SIDH, uint8_t tempRXBn_SIDL)
+{
+    uint32_t returnValue = 0;
+    uint32_t ConvertedID = 0;
+    uint8_t CAN_standardLo_ID_lo2bits;
+    uint8_t CAN_standardLo_ID_hi3bits;
+
+    CAN_standardLo_ID_lo2bits = (uint8_t) (tempRXBn_SIDL & 0x03);
+    CAN_standardLo_ID_hi3bits = (uint8_t) (tempRXBn_SIDL >> 5);
+    ConvertedID = (uint32_t) tempRXBn_SIDH;
+    ConvertedID = ConvertedID << 3;
+    ConvertedID = ConvertedID + CAN_standardLo_ID_hi3bits;
+    ConvertedID = ConvertedID << 2;
+    ConvertedID = ConvertedID + CAN_standardLo_ID_lo2bits;
+    ConvertedID = ConvertedID << 8;
+    ConvertedID = ConvertedID + tempRXBn_EIDH;
+    ConvertedID = ConvertedID << 8;
+    ConvertedID = ConvertedID + tempRXBn_EIDL;
+    returnValue = ConvertedID;
+    return (returnValue);
+}
+
+static uint32_t convertReg2StandardCANid(uint8_t tempRXBn_SIDH, uint8_t tempRXBn_SIDL)
+{
+    uint32_t returnValue = 0;
+    uint32_t ConvertedID;
+    //if standard message (11 bits)
+    //EIDH = 0 + EIDL = 0 + SIDH + upper three bits SIDL (3rd bit needs to be clear)
+    //1111 1111 111
+    ConvertedID = (uint32_t) (tempRXBn_SIDH << 3);
+    ConvertedID = ConvertedID + (uint32_t) (tempRXBn_SIDL >> 5);
+    returnValue = ConvertedID;
+    return (returnValue);
+}
+
+static void convertCANid2Reg(uint32_t tempPassedInID, uint8_t canIdType, uint8_t *passedInEIDH, uint8_t *passedInEIDL, uint8_t *passedInSIDH, uint8_t *passedInSIDL)
+{
+    uint8_t wipSIDL = 0;
+
+    if (canIdType == dEXTENDED_CAN_MSG_ID_2_0B)
+    {
+        //EIDL
+        *passedInEIDL = 0xFF & tempPassedInID; //CAN_extendedLo_ID_TX1 = &HFF And CAN_UserEnter_ID_TX1
+        tempPassedInID = tempPassedInID >> 8; //CAN_UserEnter_ID_TX1 = CAN_UserEnter_ID_TX1 >> 8
+
+        //EIDH
+        *passedInEIDH = 0xFF & tempPassedInID; //CAN_extendedHi_ID_TX1 = &HFF And CAN_UserEnter_ID_TX1
+        tempPassedInID = tempPassedInID >> 8; //CAN_UserEnter_ID_TX1 = CAN_UserEnter_ID_TX1 >> 8
+
+        //SIDL
+        //push back 5 and or it
+        wipSIDL = 0x03 & tempPassedInID;
+        tempPassedInID = tempPassedInID << 3; //CAN_UserEnter_ID_TX1 = CAN_UserEnter_ID_TX1 << 3
+        wipSIDL = (0xE0 & tempPassedInID) + wipSIDL;
+        wipSIDL = (uint8_t) (wipSIDL + 0x08); // TEMP_CAN_standardLo_ID_TX1 = TEMP_CAN_standardLo_ID_TX1 + &H8
+        *passedInSIDL = (uint8_t) (0xEB & wipSIDL); //CAN_standardLo_ID_TX1 = &HEB And TEMP_CAN_standardLo_ID_TX1
+
+        //SIDH
+        tempPassedInID = tempPassedInID >> 8;
+        *passedInSIDH = 0xFF & tempPassedInID;
+    }
+    else //(canIdType == dSTANDARD_CAN_MSG_ID_2_0B)
+    {
+        *passedInEIDH = 0;
+        *passedInEIDL = 0;
+        tempPassedInID = tempPassedInID << 5;
+        *passedInSIDL = 0xFF & tempPassedInID;
+        tempPassedInID = tempPassedInID >> 8;
+        *passedInSIDH = 0xFF & tempPassedInID;
+    }
+}
+/**
+ End of File
+*/
@@ -0,0 +1,492 @@
+/**
+  ECAN Generated Driver File
+
+  @Company
+    Microchip Technology Inc.
+
+  @File Name
+    ecan.h
+
+  @Summary
+    This is the generated header file for the ECAN driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description
+    This header file provides APIs for driver for ECAN.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F26K83
+        Driver Version    :  2.12.0
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above
+        MPLAB             :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+#ifndef ECAN_H
+#define ECAN_H
+
+/**
+  Section: Included Files
+*/
+
+#include <xc.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+
+/**
+  Section: Macro Declarations
+*/
+
+#define dSTANDARD_CAN_MSG_ID_2_0B 1
+#define dEXTENDED_CAN_MSG_ID_2_0B 2
+
+// Hardware TX buffers TXB0 to TXB2
+#define ECAN_TX_BUFFER_COUNT 3
+
+// Build with ECAN_LOOPBACK=1 to bench test without a bus: frames are
+// received back internally and TX interrupts still fire
+#ifndef ECAN_LOOPBACK
+#define ECAN_LOOPBACK 0
+#endif
+
+/**
+  Section: Data Type Definitions
+*/
+
+typedef union {
+
+    struct {
+        uint8_t idType;
+        uint32_t id;
+        uint8_t dlc;
+        uint8_t data0;
+        uint8_t data1;
+        uint8_t data2;
+        uint8_t data3;
+        uint8_t data4;
+        uint8_t data5;
+        uint8_t data6;
+        uint8_t data7;
+    } frame;
+    uint8_t array[14];
+} uCAN_MSG;
+
+// REQOP/OPMODE values of CANCON/CANSTAT
+typedef enum {
+    ECAN_NORMAL_MODE = 0x00,
+    ECAN_DISABLE_MODE = 0x20,
+    ECAN_LOOPBACK_MODE = 0x40,
+    ECAN_LISTEN_ONLY_MODE = 0x60,
+    ECAN_CONFIGURATION_MODE = 0x80
+} ECAN_OP_MODES;
+
+/**
+  Section: ECAN APIs
+*/
+
+/**
+  @Summary
+    Initializes the ECAN module
+
+  @Description
+    Sets up legacy mode 0 at 500 kbps for the 8 MHz low-power clock with
+    the acceptance filters listed in ecan.c, enables the TX and RX buffer
+    interrupts and puts the module on the bus (in loopback mode when
+    ECAN_LOOPBACK is set). The clock profile code re-derives the
+    prescaler when Fosc changes, see ECAN_SetBaudRatePrescaler().
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void ECAN_Initialize(void);
+
+/**
+  @Summary
+    Requests an operation mode and waits until the module is in it
+
+  @Description
+    Entering configuration mode waits for a frame on the bus to finish, so
+    this can take up to one frame time.
+
+  @Preconditions
+    ECAN_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    mode - mode to request
+
+  @Returns
+    None
+*/
+void ECAN_SetOperationMode(ECAN_OP_MODES mode);
+
+/**
+  @Summary
+    Returns the current operation mode
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    Mode from CANSTAT
+*/
+ECAN_OP_MODES ECAN_GetOperationMode(void);
+
+/**
+  @Summary
+    Sets a TX buffer's transmit priority
+
+  @Description
+    When several buffers are pending, the one with the highest priority is
+    sent first; with equal priorities the highest-numbered buffer goes
+    first.
+
+  @Preconditions
+    The buffer must not be pending (TXREQ clear).
+
+  @Param
+    buffer   - 0 to ECAN_TX_BUFFER_COUNT - 1
+    priority - 0 (lowest) to 3
+
+  @Returns
+    None
+*/
+void ECAN_SetTXBnPriority(uint8_t buffer, uint8_t priority);
+
+/**
+  @Summary
+    Sets the baud rate prescaler
+
+  @Description
+    TQ = 2 * (brp + 1) / Fosc. The bit is 8 TQ long (sync 1, propagation 1,
+    phase 1 4, phase 2 2, sampled at 75%).
+
+  @Preconditions
+    The module must be in ECAN_CONFIGURATION_MODE, otherwise the write is
+    ignored by the hardware.
+
+  @Param
+    brp - prescaler, 0 to 63
+
+  @Returns
+    None
+*/
+void ECAN_SetBaudRatePrescaler(uint8_t brp);
+
+/**
+  @Summary
+    Loads a message into the first free TX buffer
+
+  @Preconditions
+    ECAN_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    tempCanMsg - message to send
+
+  @Returns
+    1 if the message was loaded, 0 if all TX buffers are busy
+*/
+uint8_t CAN_transmit(uCAN_MSG *tempCanMsg);
+
+/**
+  @Summary
+    Loads a message into one TX buffer
+
+  @Description
+    Lets the caller track which buffer a message went into, e.g. to match
+    it with the buffer's TX interrupt.
+
+  @Preconditions
+    ECAN_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    buffer     - 0 to ECAN_TX_BUFFER_COUNT - 1
+    tempCanMsg - message to send
+
+  @Returns
+    1 if the message was loaded, 0 if the buffer is still sending
+*/
+uint8_t CAN_transmitBuffer(uint8_t buffer, uCAN_MSG *tempCanMsg);
+
+/**
+  @Summary
+    Checks whether a TX buffer still holds a message to send
+
+  @Preconditions
+    None
+
+  @Param
+    buffer - 0 to ECAN_TX_BUFFER_COUNT - 1
+
+  @Returns
+    1 while the buffer's TXREQ is set
+*/
+uint8_t CAN_isTXBufferPending(uint8_t buffer);
+
+/**
+  @Summary
+    Aborts the message waiting in a TX buffer
+
+  @Description
+    Clears TXREQ. A message that is not on the bus yet is dropped at once
+    (TXABT is set); one that is already being sent finishes first, so the
+    buffer is free again within one frame time. Poll
+    CAN_isTXBufferPending() before loading it again.
+
+  @Preconditions
+    None
+
+  @Param
+    buffer - 0 to ECAN_TX_BUFFER_COUNT - 1
+
+  @Returns
+    None
+*/
+void CAN_abortTransmitBuffer(uint8_t buffer);
+
+/**
+  @Summary
+    Reads a received message
+
+  @Preconditions
+    ECAN_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    tempCanMsg - receives the message
+
+  @Returns
+    1 if a message was read, 0 if both RX buffers are empty
+*/
+uint8_t CAN_receive(uCAN_MSG *tempCanMsg);
+
+/**
+  @Summary
+    Returns the number of messages waiting in the RX buffers
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    0 to 2
+*/
+uint8_t CAN_messagesInBuffer(void);
+
+/**
+  @Summary
+    Checks and clears the RX buffer overflow flags
+
+  @Description
+    A message was lost if it arrived while both RX buffers were full.
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    1 if a message was lost since the last call
+*/
+uint8_t CAN_hasRXOverflowed(void);
+
+/**
+  @Summary
+    Checks whether the module is bus off
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    1 if the TX error counter has passed 255
+*/
+uint8_t CAN_isBusOff(void);
+
+/**
+  @Summary
+    Checks whether the receiver is error passive
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    1 if the RX error counter is over 127
+*/
+uint8_t CAN_isRXErrorPassive(void);
+
+/**
+  @Summary
+    Checks whether the transmitter is error passive
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    1 if the TX error counter is over 127
+*/
+uint8_t CAN_isTXErrorPassive(void);
+
+/**
+  @Summary
+    Implements the ISR for the TX buffer interrupts
+
+  @Description
+    Clears the flag of every TX buffer that has finished sending and calls
+    that buffer's interrupt handler with its index.
+
+  @Preconditions
+    ECAN_Initialize() function should have been called
+    for the ISR to execute correctly.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void ECAN_TXBnI_ISR(void);
+
+/**
+  @Summary
+    Sets the interrupt handler of one TX buffer
+
+  @Description
+    The handler runs in interrupt context when the buffer has sent its
+    message, with the buffer's index, and may load the buffer again.
+    Buffers can have different owners this way.
+
+  @Preconditions
+    None
+
+  @Param
+    buffer           - 0 to ECAN_TX_BUFFER_COUNT - 1
+    InterruptHandler - address of the function to call
+
+  @Returns
+    None
+*/
+void ECAN_SetTXBnInterruptHandler(uint8_t buffer, void (* InterruptHandler)(uint8_t buffer));
+
+/**
+  @Summary
+    Default TX buffer interrupt handler
+
+  @Param
+    buffer - index of the buffer that finished
+
+  @Returns
+    None
+*/
+void ECAN_DefaultTXBnInterruptHandler(uint8_t buffer);
+
+/**
+  @Summary
+    Implements the ISR for the RX buffer interrupts
+
+  @Description
+    Clears the RXB0 and RXB1 flags and calls the RXBn interrupt handler,
+    which should read every waiting message with CAN_receive().
+
+  @Preconditions
+    ECAN_Initialize() function should have been called
+    for the ISR to execute correctly.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void ECAN_RXBnI_ISR(void);
+
+/**
+  @Summary
+    Sets the RX buffer interrupt handler
+
+  @Preconditions
+    None
+
+  @Param
+    Address of the function to call
+
+  @Returns
+    None
+*/
+void ECAN_SetRXBnInterruptHandler(void (* InterruptHandler)(void));
+
+/**
+  @Summary
+    Default RX buffer interrupt handler
+
+  @Description
+    Discards the received messages so the buffers do not stay full.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void ECAN_DefaultRXBnInterruptHandler(void);
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+
+#endif // ECAN_H
+/**
+ End of File
+*/
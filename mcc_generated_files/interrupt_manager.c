@@ -0,0 +1,128 @@
+/**
+  Generated Interrupt Manager Source File
+
+  @Company:
+    Microchip Technology Inc.
+
+  @File Name:
+    interrupt_manager.c
+
+  @Summary:
+    This is the Interrupt Manager file generated using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description:
+    This header file provides implementations for global interrupt handling.
+    For individual peripheral handlers please see the peripheral driver for
+    all modules selected in the GUI.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F26K83
+        Driver Version    :  2.12
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above or later
+        MPLAB 	          :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+#include "interrupt_manager.h"
+#include "mcc.h"
+
+static volatile uint16_t interruptBusyCounts = 0;
+
+void  INTERRUPT_Initialize (void)
+{
+    // Disable Interrupt Priority Vectors (16CXXX Compatibility Mode)
+    INTCON0bits.IPEN = 0;
+}
+
+void __interrupt() INTERRUPT_InterruptManager (void)
+{
+    // Reading TMR1L latches TMR1H, so keep the latch of a read this
+    // interrupt may have split and put it back on the way out
+    uint8_t tmr1Latch = TMR1H;
+    uint16_t entryCounts = TMR1_ReadTimer();
+
+    // interrupt handler
+    if(PIE3bits.TMR0IE == 1 && PIR3bits.TMR0IF == 1)
+    {
+        TMR0_ISR();
+    }
+    else if(PIE0bits.IOCIE == 1 && PIR0bits.IOCIF == 1)
+    {
+        PIN_MANAGER_IOC();
+    }
+    else if(PIE1bits.ADIE == 1 && PIR1bits.ADIF == 1)
+    {
+        ADCC_ISR();
+    }
+    else if(PIE1bits.ADTIE == 1 && PIR1bits.ADTIF == 1)
+    {
+        ADCC_ThresholdISR();
+    }
+    else if(PIE2bits.DMA1DCNTIE == 1 && PIR2bits.DMA1DCNTIF == 1)
+    {
+        DMA1_DMADCNTI_ISR();
+    }
+    else if(PIE10bits.DMA2SCNTIE == 1 && PIR10bits.DMA2SCNTIF == 1)
+    {
+        DMA2_DMASCNTI_ISR();
+    }
+#if !UART1_TX_DMA
+    else if(PIE3bits.U1TXIE == 1 && PIR3bits.U1TXIF == 1)
+    {
+        UART1_Transmit_ISR();
+    }
+#endif
+    else if(PIE3bits.U1RXIE == 1 && PIR3bits.U1RXIF == 1)
+    {
+        UART1_RxInterruptHandler();
+    }
+    else if((PIE5bits.TXB0IE == 1 && PIR5bits.TXB0IF == 1)
+            || (PIE5bits.TXB1IE == 1 && PIR5bits.TXB1IF == 1)
+            || (PIE5bits.TXB2IE == 1 && PIR5bits.TXB2IF == 1))
+    {
+        ECAN_TXBnI_ISR();
+    }
+    else if((PIE5bits.RXB0IE == 1 && PIR5bits.RXB0IF == 1)
+            || (PIE5bits.RXB1IE == 1 && PIR5bits.RXB1IF == 1))
+    {
+        ECAN_RXBnI_ISR();
+    }
+    else
+    {
+        //Unhandled Interrupt
+    }
+
+    interruptBusyCounts += TMR1_ReadTimer() - entryCounts;
+    TMR1H = tmr1Latch;
+}
+
+uint16_t INTERRUPT_GetBusyCounts(void)
+{
+    return interruptBusyCounts;
+}
+/**
+ End of File
+*/
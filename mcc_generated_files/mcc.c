@@ -49,11 +49,20 @@
 
 void SYSTEM_Initialize(void)
 {
+    INTERRUPT_Initialize();
     PMD_Initialize();
     PIN_MANAGER_Initialize();
     OSCILLATOR_Initialize();
     ADCC_Initialize();
+    DMA1_Initialize();
+    DMA2_Initialize();
+    TMR0_Initialize();
+    TMR1_Initialize();
+    TMR2_Initialize();
     UART1_Initialize();
+    CRC_Initialize();
+    ECAN_Initialize();
+    SystemArbiter_Initialize();
 }
 
 void OSCILLATOR_Initialize(void)
@@ -64,8 +73,8 @@ void OSCILLATOR_Initialize(void)
     OSCCON3 = 0x00;
     // MFOEN disabled; LFOEN disabled; ADOEN disabled; SOSCEN disabled; EXTOEN disabled; HFOEN disabled; 
     OSCEN = 0x00;
-    // HFFRQ 1_MHz; 
-    OSCFRQ = 0x00;
+    // HFFRQ 8_MHz; 
+    OSCFRQ = 0x03;
     // TUN 0; 
     OSCTUNE = 0x00;
 }
@@ -90,6 +99,23 @@ void PMD_Initialize(void)
     PMD7 = 0x00;
 }
 
+void SystemArbiter_Initialize(void)
+{
+    // DMA1 first so ADC results are copied before the ADC ISR starts the
+    // next conversion
+    // DMA1PR 0; ISRPR 1; DMA2PR 2; MAINPR 3; SCANPR 4; 
+    DMA1PR = 0x00;
+    ISRPR = 0x01;
+    DMA2PR = 0x02;
+    MAINPR = 0x03;
+    SCANPR = 0x04;
+
+    // This function is dependant on the PR1WAY CONFIG bit
+    PRLOCK = 0x55;
+    PRLOCK = 0xAA;
+    PRLOCKbits.PRLOCKED = 1;
+}
+
 
 /**
  End of File
@@ -52,8 +52,16 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <conio.h>
+#include "interrupt_manager.h"
 #include "adcc.h"
+#include "dma1.h"
+#include "dma2.h"
+#include "tmr0.h"
+#include "tmr1.h"
+#include "tmr2.h"
 #include "uart1.h"
+#include "crc.h"
+#include "ecan.h"
 
 
 
@@ -96,6 +104,19 @@ void OSCILLATOR_Initialize(void);
  */
 void PMD_Initialize(void);
 
+/**
+ * @Param
+    none
+ * @Returns
+    none
+ * @Description
+    Sets the bus arbiter priorities and locks them, which the DMA needs
+    before it can run
+ * @Example
+    SystemArbiter_Initialize(void);
+ */
+void SystemArbiter_Initialize(void);
+
 
 #endif	/* MCC_H */
 /**
@@ -51,6 +51,9 @@
 
 
 
+void (*IOCBF2_InterruptHandler)(void);
+void (*IOCBF7_InterruptHandler)(void);
+
 
 void PIN_MANAGER_Initialize(void)
 {
@@ -65,14 +68,14 @@ void PIN_MANAGER_Initialize(void)
     TRISx registers
     */
     TRISA = 0xFF;
-    TRISB = 0xFF;
+    TRISB = 0xEF;
     TRISC = 0xBF;
 
     /**
     ANSELx registers
     */
     ANSELC = 0x7F;
-    ANSELB = 0xFB;
+    ANSELB = 0x63;
     ANSELA = 0xFE;
 
     /**
@@ -106,18 +109,115 @@ void PIN_MANAGER_Initialize(void)
     INLVLE = 0x08;
 
 
+    /**
+    IOCx registers 
+    */
+    //interrupt on change for group IOCBF - flag
+    IOCBFbits.IOCBF2 = 0;
+    //interrupt on change for group IOCBF - flag
+    IOCBFbits.IOCBF7 = 0;
+    //interrupt on change for group IOCBN - negative
+    IOCBNbits.IOCBN2 = 1;
+    //interrupt on change for group IOCBN - negative
+    IOCBNbits.IOCBN7 = 1;
+    //interrupt on change for group IOCBP - positive
+    IOCBPbits.IOCBP2 = 1;
+    //interrupt on change for group IOCBP - positive
+    IOCBPbits.IOCBP7 = 1;
+
+
+
+    // register default IOC callback functions at runtime; use these methods to register a custom function
+    IOCBF2_SetInterruptHandler(IOCBF2_DefaultInterruptHandler);
+    IOCBF7_SetInterruptHandler(IOCBF7_DefaultInterruptHandler);
+   
+    // Enable IOCI interrupt 
+    PIE0bits.IOCIE = 1; 
+    
 
 
 
    
     
 	
+    CANRXPPS = 0x0B;   //RB3->ECAN:CANRX;    
+    RB4PPS = 0x33;   //RB4->ECAN:CANTX0;    
     RC6PPS = 0x13;   //RC6->UART1:TX1;    
     U1RXPPS = 0x17;   //RC7->UART1:RX1;    
 }
   
 void PIN_MANAGER_IOC(void)
 {   
+	// interrupt on change for pin IOCBF2
+    if(IOCBFbits.IOCBF2 == 1)
+    {
+        IOCBF2_ISR();  
+    }	
+	// interrupt on change for pin IOCBF7
+    if(IOCBFbits.IOCBF7 == 1)
+    {
+        IOCBF7_ISR();  
+    }	
+}
+
+/**
+   IOCBF2 Interrupt Service Routine
+*/
+void IOCBF2_ISR(void) {
+
+    // Add custom IOCBF2 code
+
+    // Call the interrupt handler for the callback registered at runtime
+    if(IOCBF2_InterruptHandler)
+    {
+        IOCBF2_InterruptHandler();
+    }
+    IOCBFbits.IOCBF2 = 0;
+}
+
+/**
+  Allows selecting an interrupt handler for IOCBF2 at application runtime
+*/
+void IOCBF2_SetInterruptHandler(void (* InterruptHandler)(void)){
+    IOCBF2_InterruptHandler = InterruptHandler;
+}
+
+/**
+  Default interrupt handler for IOCBF2
+*/
+void IOCBF2_DefaultInterruptHandler(void){
+    // add your IOCBF2 interrupt custom code
+    // or set custom function using IOCBF2_SetInterruptHandler()
+}
+
+/**
+   IOCBF7 Interrupt Service Routine
+*/
+void IOCBF7_ISR(void) {
+
+    // Add custom IOCBF7 code
+
+    // Call the interrupt handler for the callback registered at runtime
+    if(IOCBF7_InterruptHandler)
+    {
+        IOCBF7_InterruptHandler();
+    }
+    IOCBFbits.IOCBF7 = 0;
+}
+
+/**
+  Allows selecting an interrupt handler for IOCBF7 at application runtime
+*/
+void IOCBF7_SetInterruptHandler(void (* InterruptHandler)(void)){
+    IOCBF7_InterruptHandler = InterruptHandler;
+}
+
+/**
+  Default interrupt handler for IOCBF7
+*/
+void IOCBF7_DefaultInterruptHandler(void){
+    // add your IOCBF7 interrupt custom code
+    // or set custom function using IOCBF7_SetInterruptHandler()
 }
 
 /**
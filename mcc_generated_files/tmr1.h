@@ -0,0 +1,198 @@
+/**
+  TMR1 Generated Driver API Header File
+
+  @Company
+    Microchip Technology Inc.
+
+  @File Name
+    tmr1.h
+
+  @Summary
+    This is the generated header file for the TMR1 driver using PIC10 / PIC12 / PIC16 / PIC18 MCUs
+
+  @Description
+    This header file provides APIs for driver for TMR1.
+    Generation Information :
+        Product Revision  :  PIC10 / PIC12 / PIC16 / PIC18 MCUs - 1.81.7
+        Device            :  PIC18F26K83
+        Driver Version    :  2.11
+    The generated drivers are tested against the following:
+        Compiler          :  XC8 2.31 and above
+        MPLAB             :  MPLAB X 5.45
+*/
+
+/*
+    (c) 2018 Microchip Technology Inc. and its subsidiaries. 
+    
+    Subject to your compliance with these terms, you may use Microchip software and any 
+    derivatives exclusively with Microchip products. It is your responsibility to comply with third party 
+    license terms applicable to your use of third party software (including open source software) that 
+    may accompany Microchip software.
+    
+    THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER 
+    EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY 
+    IMPLIED WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS 
+    FOR A PARTICULAR PURPOSE.
+    
+    IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE, 
+    INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND 
+    WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP 
+    HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO 
+    THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL 
+    CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT 
+    OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS 
+    SOFTWARE.
+*/
+
+#ifndef TMR1_H
+#define TMR1_H
+
+/**
+  Section: Included Files
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+
+/**
+  Section: TMR1 APIs
+*/
+
+/**
+  @Summary
+    Initializes the TMR1
+
+  @Description
+    This routine initializes the TMR1.
+    This routine must be called before any other TMR1 routine is called.
+    This routine should only be called once during system initialization.
+    TMR1 free-runs from the 500 kHz MFINTOSC with no interrupt so it can be
+    read as a timestamp counter.
+
+  @Preconditions
+    None
+
+  @Param
+    None
+
+  @Returns
+    None
+
+  @Example
+    <code>
+    TMR1_Initialize();
+    </code>
+*/
+void TMR1_Initialize(void);
+
+/**
+  @Summary
+    This function starts the TMR1.
+
+  @Description
+    This function starts the TMR1 operation.
+    This function must be called after the initialization of TMR1.
+
+  @Preconditions
+    Initialize  the TMR1 before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void TMR1_StartTimer(void);
+
+/**
+  @Summary
+    This function stops the TMR1.
+
+  @Description
+    This function stops the TMR1 operation.
+    This function must be called after the start of TMR1.
+
+  @Preconditions
+    Initialize  the TMR1 before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void TMR1_StopTimer(void);
+
+/**
+  @Summary
+    Reads the TMR1 register.
+
+  @Description
+    This function reads the TMR1 register value and return it.
+
+  @Preconditions
+    Initialize  the TMR1 before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    This function returns the current value of TMR1 register
+*/
+uint16_t TMR1_ReadTimer(void);
+
+/**
+  @Summary
+    Writes the TMR1 register.
+
+  @Description
+    This function writes the TMR1 register.
+    This function must be called after the initialization of TMR1.
+
+  @Preconditions
+    Initialize  the TMR1 before calling this function.
+
+  @Param
+    timerVal - Value to write into TMR1 register.
+
+  @Returns
+    None
+*/
+void TMR1_WriteTimer(uint16_t timerVal);
+
+/**
+  @Summary
+    Boolean routine to poll or to check for the overflow flag on the fly.
+
+  @Description
+    This function is called to check for the timer overflow flag.
+    This function is usd in timer polling method.
+
+  @Preconditions
+    Initialize  the TMR1 module before calling this routine.
+
+  @Param
+    None
+
+  @Returns
+    true - timer overflow has occured.
+    false - timer overflow has not occured.
+*/
+bool TMR1_HasOverflowOccured(void);
+
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+
+#endif
+
+#endif // TMR1_H
+/**
+ End of File
+*/
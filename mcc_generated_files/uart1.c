@@ -49,7 +49,37 @@
 */
 #include <xc.h>
 #include "uart1.h"
-
+#include "dma2.h"
+
+// U1TX interrupt vector number, used as the DMA2 start trigger
+#define DMA_TRIGGER_U1TX 0x1C
+
+#if UART1_TX_DMA
+// The DMA2 chunk interrupt updates the TX ring state
+#define UART1_TxInterruptDisable()  (PIE10bits.DMA2SCNTIE = 0)
+#define UART1_TxInterruptEnable()   (PIE10bits.DMA2SCNTIE = 1)
+#else
+// U1TXIE stays off while the ring is empty, or U1TXIF would keep firing
+#define UART1_TxInterruptDisable()  (PIE3bits.U1TXIE = 0)
+#define UART1_TxInterruptEnable()   (PIE3bits.U1TXIE = (sizeof(uart1TxBuffer) != uart1TxBufferRemaining))
+#endif
+
+static volatile uint8_t uart1TxHead = 0;
+static volatile uint8_t uart1TxTail = 0;
+static volatile uint8_t uart1TxBuffer[UART1_TX_BUFFER_SIZE];
+volatile uint16_t uart1TxBufferRemaining;
+static volatile uint16_t uart1TxDropped;
+#if UART1_TX_DMA
+static volatile uint16_t uart1TxChunk;         // bytes DMA2 is sending, 0 when idle
+#endif
+static volatile uint32_t uart1TxSent;
+static volatile uint16_t uart1TxInterrupts;
+
+static volatile uint8_t uart1RxHead = 0;
+static volatile uint8_t uart1RxTail = 0;
+static volatile uint8_t uart1RxBuffer[UART1_RX_BUFFER_SIZE];
+static volatile uart1_status_t uart1RxStatusBuffer[UART1_RX_BUFFER_SIZE];
+volatile uint8_t uart1RxCount;
 static volatile uart1_status_t uart1RxLastError;
 
 /**
@@ -59,6 +89,8 @@ void (*UART1_FramingErrorHandler)(void);
 void (*UART1_OverrunErrorHandler)(void);
 void (*UART1_ErrorHandler)(void);
 
+void (*UART1_RxInterruptHandler)(void);
+
 void UART1_DefaultFramingErrorHandler(void);
 void UART1_DefaultOverrunErrorHandler(void);
 void UART1_DefaultErrorHandler(void);
@@ -66,6 +98,17 @@ void UART1_DefaultErrorHandler(void);
 void UART1_Initialize(void)
 {
     // Disable interrupts before changing states
+    PIE3bits.U1RXIE = 0;
+    UART1_SetRxInterruptHandler(UART1_Receive_ISR);
+    PIE3bits.U1TXIE = 0;
+
+#if UART1_TX_DMA
+    // DMA2 copies the TX ring to U1TXB whenever U1TXIF is set
+    DMA2_SetDestinationAddress((uint16_t) &U1TXB);
+    DMA2_SetDestinationSize(1);
+    DMA2_SetStartTrigger(DMA_TRIGGER_U1TX);
+    DMA2_SetDMASourceCountInterruptHandler(UART1_Transmit_ISR);
+#endif
 
     // Set the UART1 module to the options selected in the user interface.
 
@@ -96,8 +139,8 @@ void UART1_Initialize(void)
     // TXPOL not inverted; FLO off; C0EN Checksum Mode 0; RXPOL not inverted; RUNOVF RX input shifter stops all activity; STP Transmit 1Stop bit, receiver verifies first Stop bit; 
     U1CON2 = 0x00;
 
-    // BRGL 25; 
-    U1BRGL = 0x19;
+    // BRGL 207; 
+    U1BRGL = 0xCF;
 
     // BRGH 0; 
     U1BRGH = 0x00;
@@ -121,16 +164,32 @@ void UART1_Initialize(void)
 
     uart1RxLastError.status = 0;
 
+    // initializing the driver state
+    uart1RxHead = 0;
+    uart1RxTail = 0;
+    uart1RxCount = 0;
+    uart1TxHead = 0;
+    uart1TxTail = 0;
+    uart1TxBufferRemaining = sizeof(uart1TxBuffer);
+    uart1TxDropped = 0;
+#if UART1_TX_DMA
+    uart1TxChunk = 0;
+#endif
+    uart1TxSent = 0;
+    uart1TxInterrupts = 0;
+
+    // enable receive interrupt
+    PIE3bits.U1RXIE = 1;
 }
 
 bool UART1_is_rx_ready(void)
 {
-    return (bool)(PIR3bits.U1RXIF);
+    return (bool)(uart1RxCount ? true : false);
 }
 
 bool UART1_is_tx_ready(void)
 {
-    return (bool)(PIR3bits.U1TXIF && U1CON0bits.TXEN);
+    return (bool)(uart1TxBufferRemaining ? true : false);
 }
 
 bool UART1_is_tx_done(void)
@@ -144,36 +203,207 @@ uart1_status_t UART1_get_last_status(void){
 
 uint8_t UART1_Read(void)
 {
-    while(!PIR3bits.U1RXIF)
+    uint8_t readValue  = 0;
+
+    while(0 == uart1RxCount)
     {
     }
 
-    uart1RxLastError.status = 0;
+    uart1RxLastError = uart1RxStatusBuffer[uart1RxTail];
+
+    readValue = uart1RxBuffer[uart1RxTail++];
+    if(sizeof(uart1RxBuffer) <= uart1RxTail)
+    {
+        uart1RxTail = 0;
+    }
+    PIE3bits.U1RXIE = 0;
+    uart1RxCount--;
+    PIE3bits.U1RXIE = 1;
+
+    return readValue;
+}
+
+#if UART1_TX_DMA
+// Starts DMA2 on the queued bytes from the tail up to the end of the ring.
+// Call with the DMA2 interrupt masked, or from its ISR
+static void UART1_StartTxDma(void)
+{
+    uint16_t queued = sizeof(uart1TxBuffer) - uart1TxBufferRemaining;
+    uint16_t contiguous = sizeof(uart1TxBuffer) - uart1TxTail;
+
+    uart1TxChunk = (queued < contiguous) ? queued : contiguous;
+    if(0 == uart1TxChunk)
+    {
+        return;
+    }
+
+    DMA2_SetSourceAddress((uint24_t) &uart1TxBuffer[uart1TxTail]);
+    DMA2_SetSourceSize(uart1TxChunk);
+    DMA2_StartTransferWithTrigger();
+}
+#endif
+
+void UART1_Write(uint8_t txData)
+{
+    UART1_TxInterruptDisable();
+
+    if(0 == uart1TxBufferRemaining)
+    {
+        // Drop the newest byte rather than block the caller
+        if(0xFFFF != uart1TxDropped)
+        {
+            uart1TxDropped++;
+        }
+    }
+    else
+    {
+        uart1TxBuffer[uart1TxHead++] = txData;    // 8-bit index wraps with the 256-byte buffer
+        uart1TxBufferRemaining--;
+
+#if UART1_TX_DMA
+        // Otherwise the byte joins the next chunk when this one completes
+        if(0 == uart1TxChunk)
+        {
+            UART1_StartTxDma();
+        }
+#endif
+    }
+
+    UART1_TxInterruptEnable();
+}
+
+uint16_t UART1_get_tx_dropped(void)
+{
+    return uart1TxDropped;
+}
+
+uint16_t UART1_get_tx_free(void)
+{
+    uint16_t remaining;
+
+    // 16-bit count is updated by the ISR
+    UART1_TxInterruptDisable();
+    remaining = uart1TxBufferRemaining;
+    UART1_TxInterruptEnable();
+
+    return remaining;
+}
+
+uint32_t UART1_get_tx_sent(void)
+{
+    uint32_t sent;
+
+    UART1_TxInterruptDisable();
+    sent = uart1TxSent;
+    UART1_TxInterruptEnable();
+
+    return sent;
+}
+
+uint16_t UART1_get_tx_interrupts(void)
+{
+    uint16_t interrupts;
+
+    UART1_TxInterruptDisable();
+    interrupts = uart1TxInterrupts;
+    UART1_TxInterruptEnable();
+
+    return interrupts;
+}
+
+bool UART1_HoldTx(void)
+{
+    bool sending;
+
+#if UART1_TX_DMA
+    // Stays masked until the release, or a chunk completing meanwhile
+    // would start the next one and set SIRQEN again
+    PIE10bits.DMA2SCNTIE = 0;
+    sending = DMA2CON0bits.SIRQEN;
+    DMA2CON0bits.SIRQEN = 0;
+#else
+    sending = PIE3bits.U1TXIE;
+    PIE3bits.U1TXIE = 0;
+#endif
+
+    return sending;
+}
+
+void UART1_ReleaseTx(bool sending)
+{
+#if UART1_TX_DMA
+    DMA2CON0bits.SIRQEN = sending;
+    PIE10bits.DMA2SCNTIE = 1;
+#else
+    PIE3bits.U1TXIE = sending;
+#endif
+}
+
+void UART1_Transmit_ISR(void)
+{
+#if UART1_TX_DMA
+    // DMA2 has handed the whole chunk to the UART; SSTP has stopped it
+    uart1TxTail += (uint8_t) uart1TxChunk;    // 8-bit index wraps with the 256-byte buffer
+    uart1TxBufferRemaining += uart1TxChunk;
+    uart1TxSent += uart1TxChunk;
+    uart1TxInterrupts++;
+
+    UART1_StartTxDma();
+#else
+    // U1TXIE is only on while bytes are queued
+    U1TXB = uart1TxBuffer[uart1TxTail++];    // 8-bit index wraps with the 256-byte buffer
+    uart1TxBufferRemaining++;
+    uart1TxSent++;
+    uart1TxInterrupts++;
+
+    if(sizeof(uart1TxBuffer) == uart1TxBufferRemaining)
+    {
+        PIE3bits.U1TXIE = 0;
+    }
+#endif
+}
+
+void UART1_Receive_ISR(void)
+{
+    // use this default receive interrupt handler code
+    uart1RxStatusBuffer[uart1RxHead].status = 0;
 
     if(U1ERRIRbits.FERIF){
-        uart1RxLastError.ferr = 1;
+        uart1RxStatusBuffer[uart1RxHead].ferr = 1;
         UART1_FramingErrorHandler();
     }
 
     if(U1ERRIRbits.RXFOIF){
-        uart1RxLastError.oerr = 1;
+        uart1RxStatusBuffer[uart1RxHead].oerr = 1;
         UART1_OverrunErrorHandler();
     }
 
-    if(uart1RxLastError.status){
+    if(uart1RxStatusBuffer[uart1RxHead].status){
         UART1_ErrorHandler();
+    } else {
+        UART1_RxDataHandler();
     }
 
-    return U1RXB;
+    // or set custom function using UART1_SetRxInterruptHandler()
 }
 
-void UART1_Write(uint8_t txData)
-{
-    while(0 == PIR3bits.U1TXIF)
+void UART1_RxDataHandler(void){
+    // use this default receive interrupt handler code
+    uint8_t data = U1RXB;
+
+    // Drop the byte rather than overwrite unread ones; the console sees a
+    // garbled line and rejects it
+    if(sizeof(uart1RxBuffer) <= uart1RxCount)
     {
+        return;
     }
 
-    U1TXB = txData;    // Write the data byte to the USART.
+    uart1RxBuffer[uart1RxHead++] = data;
+    if(sizeof(uart1RxBuffer) <= uart1RxHead)
+    {
+        uart1RxHead = 0;
+    }
+    uart1RxCount++;
 }
 
 char getch(void)
@@ -192,9 +422,14 @@ void putch(char txData)
 
 void UART1_DefaultFramingErrorHandler(void){}
 
-void UART1_DefaultOverrunErrorHandler(void){}
+void UART1_DefaultOverrunErrorHandler(void){
+    // Clear the overrun so the receiver keeps running
+    U1ERRIRbits.RXFOIF = 0;
+}
 
 void UART1_DefaultErrorHandler(void){
+    // Still pull the byte out of the FIFO, or U1RXIF stays set
+    UART1_RxDataHandler();
 }
 
 void UART1_SetFramingErrorHandler(void (* interruptHandler)(void)){
@@ -209,6 +444,10 @@ void UART1_SetErrorHandler(void (* interruptHandler)(void)){
     UART1_ErrorHandler = interruptHandler;
 }
 
+void UART1_SetRxInterruptHandler(void (* InterruptHandler)(void)){
+    UART1_RxInterruptHandler = InterruptHandler;
+}
+
 
 
 
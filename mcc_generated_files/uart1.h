@@ -68,6 +68,17 @@
 
 #define UART1_DataReady  (UART1_is_rx_ready())
 
+// TX ring size; must stay 256 because the 8-bit head and tail wrap with it
+#define UART1_TX_BUFFER_SIZE 256
+// RX ring size; holds a console line that arrives between two polls
+#define UART1_RX_BUFFER_SIZE 32
+
+// 1: DMA2 drains the TX ring, one interrupt per chunk. 0: the U1TX
+// interrupt sends one byte at a time; kept to compare the CPU load of the two
+#ifndef UART1_TX_DMA
+#define UART1_TX_DMA 1
+#endif
+
 /**
   Section: Data Type Definitions
 */
@@ -115,8 +126,7 @@ void UART1_Initialize(void);
     Checks if the UART1 receiver ready for reading
 
   @Description
-    This routine checks if UART1 receiver has received data 
-    and ready to be read
+    This routine checks if the RX ring holds a received byte
 
   @Preconditions
     UART1_Initialize() function should be called
@@ -306,7 +316,8 @@ uart1_status_t UART1_get_last_status(void);
     Read a byte of data from the UART1.
 
   @Description
-    This routine reads a byte of data from the UART1.
+    This routine reads a byte of data from the RX ring, which the receive
+    interrupt fills. It only blocks while the ring is empty.
 
   @Preconditions
     UART1_Initialize() function should have been called
@@ -375,6 +386,187 @@ uint8_t UART1_Read(void);
 */
 void UART1_Write(uint8_t txData);
 
+/**
+  @Summary
+    Returns the number of bytes dropped by UART1_Write()
+
+  @Description
+    UART1_Write() never blocks. When the TX ring is full the new byte is
+    dropped (drop-newest), so bytes already queued are sent intact, and this
+    counter is incremented. It saturates at 0xFFFF.
+
+  @Preconditions
+    UART1_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    Number of bytes dropped since initialization
+*/
+uint16_t UART1_get_tx_dropped(void);
+
+/**
+  @Summary
+    Returns the free space in the TX ring
+
+  @Description
+    Writers that must not be cut short (e.g. framed packets) can check this
+    and skip the whole write instead of losing its tail.
+
+  @Preconditions
+    UART1_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    Number of bytes UART1_Write() can queue without dropping
+*/
+uint16_t UART1_get_tx_free(void);
+
+/**
+  @Summary
+    Maintains the driver's receiver state machine and implements its ISR
+
+  @Description
+    Moves the received byte into the RX ring, recording its framing and
+    overrun status for UART1_get_last_status(). When the ring is full the
+    byte is dropped.
+
+  @Preconditions
+    UART1_Initialize() function should have been called
+    for the ISR to execute correctly.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void UART1_Receive_ISR(void);
+
+/**
+  @Summary
+    Stores the received byte in the RX ring
+
+  @Description
+    Called by UART1_Receive_ISR() for a byte without errors, and by the
+    default error handler so a bad byte is still taken out of the FIFO.
+
+  @Preconditions
+    UART1_Initialize() function should have been called
+    for the ISR to execute correctly.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void UART1_RxDataHandler(void);
+
+/**
+  @Summary
+    Returns the number of bytes handed to the UART
+
+  @Description
+    Together with UART1_get_tx_interrupts() this gives the bytes sent per
+    TX interrupt, i.e. how much interrupt load the DMA saves.
+
+  @Preconditions
+    UART1_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    Bytes sent since initialization
+*/
+uint32_t UART1_get_tx_sent(void);
+
+/**
+  @Summary
+    Returns the number of TX interrupts taken
+
+  @Description
+    With UART1_TX_DMA one interrupt is taken per DMA2 chunk; without it,
+    one per byte.
+
+  @Preconditions
+    UART1_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    TX interrupts since initialization
+*/
+uint16_t UART1_get_tx_interrupts(void);
+
+/**
+  @Summary
+    Stops the transmitter from taking more bytes from the TX ring
+
+  @Description
+    The byte already in the UART still goes out; poll UART1_is_tx_done()
+    for it. Queued bytes stay in the ring until UART1_ReleaseTx().
+
+  @Preconditions
+    UART1_Initialize() function should have been called
+    before calling this function.
+
+  @Param
+    None
+
+  @Returns
+    Whether the ring was being drained, to pass to UART1_ReleaseTx()
+*/
+bool UART1_HoldTx(void);
+
+/**
+  @Summary
+    Undoes UART1_HoldTx()
+
+  @Preconditions
+    UART1_HoldTx() function should have been called.
+
+  @Param
+    sending - the value UART1_HoldTx() returned
+
+  @Returns
+    None
+*/
+void UART1_ReleaseTx(bool sending);
+
+/**
+  @Summary
+    Maintains the driver's transmitter state machine and implements its ISR.
+
+  @Description
+    With UART1_TX_DMA the TX ring is drained by DMA2, triggered by U1TXIF,
+    in chunks of contiguous queued bytes. This is the DMA2 source count
+    interrupt handler: it retires the finished chunk and starts DMA2 on the
+    next one, so the CPU takes one interrupt per chunk instead of one per
+    byte. Without UART1_TX_DMA this is the U1TX interrupt handler and sends
+    one byte.
+
+  @Preconditions
+    DMA2_Initialize() and UART1_Initialize() functions should have been
+    called for the ISR to execute correctly.
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+void UART1_Transmit_ISR(void);
+
 
 
 /**
@@ -441,6 +633,43 @@ void UART1_SetErrorHandler(void (* interruptHandler)(void));
 
 
 
+/**
+  @Summary
+    Set UART1 Receive Interrupt Handler
+
+  @Description
+    This API sets the function to be called upon UART1 receive interrupt
+
+  @Preconditions
+    Initialize  the UART1 module with receive interrupt enabled
+    before calling this API
+
+  @Param
+    Address of function to be set as receive interrupt handler
+
+  @Returns
+    None
+*/
+void UART1_SetRxInterruptHandler(void (* InterruptHandler)(void));
+
+/**
+  @Summary
+    UART1 Receive Interrupt Handler
+
+  @Description
+    This is a pointer to the function that will be called upon UART1 receive interrupt
+
+  @Preconditions
+    Initialize  the UART1 module with receive interrupt enabled
+
+  @Param
+    None
+
+  @Returns
+    None
+*/
+extern void (*UART1_RxInterruptHandler)(void);
+
 #ifdef __cplusplus  // Provide C++ Compatibility
 
     }
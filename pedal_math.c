@@ -0,0 +1,60 @@
+#include "pedal_math.h"
+
+void pedal_scale_init(pedal_scale_t* scale, uint16_t min, uint16_t max) {
+    scale->min = min;
+    if (max <= min) {
+        scale->range = 0;
+        scale->reciprocal = 0;
+        return;
+    }
+    
+    // The only division, done once per calibration
+    scale->range = max - min;
+    scale->reciprocal = ((100UL << 16) + scale->range - 1) / scale->range;
+}
+
+uint8_t pedal_scale_percent(const pedal_scale_t* scale, uint16_t value) {
+    if (value < scale->min) {
+        return 0;
+    }
+    return pedal_scale_percent_of(scale, value - scale->min);
+}
+
+uint8_t pedal_scale_percent_of(const pedal_scale_t* scale, uint16_t offset) {
+    if (offset >= scale->range) {
+        return (scale->range == 0) ? 0 : 100;
+    }
+    
+    // Rounding the reciprocal up overshoots by less than offset / 2^16, so
+    // the estimate is exact or one too high; one multiply tells which.
+    // offset < range keeps the product under 100 << 16
+    uint8_t percent = (uint8_t)(((uint32_t)offset * scale->reciprocal) >> 16);
+    if ((uint32_t)percent * scale->range > (uint32_t)offset * 100) {
+        percent--;
+    }
+    return percent;
+}
+
+void pedal_window_init(pedal_window_t* window, uint16_t min, uint16_t max, uint16_t margin, uint16_t full_scale) {
+    if (max < min) {
+        window->lower = 0;
+        window->upper = full_scale;
+        return;
+    }
+    window->lower = (min > margin) ? min - margin : 0;
+    window->upper = (max < full_scale - margin) ? max + margin : full_scale;
+}
+
+bool pedal_differ(uint8_t percent1, uint8_t percent2, uint8_t limit) {
+    uint8_t difference = (percent1 > percent2) ? percent1 - percent2 : percent2 - percent1;
+    return difference > limit;
+}
+
+// Cross-multiplied so no precision is lost dividing range first
+bool pedal_above_percent(uint16_t value, uint16_t range, uint8_t percent) {
+    return (uint32_t)value * 100 > (uint32_t)range * percent;
+}
+
+bool pedal_below_percent(uint16_t value, uint16_t range, uint8_t percent) {
+    return (uint32_t)value * 100 < (uint32_t)range * percent;
+}
@@ -0,0 +1,52 @@
+#ifndef PEDAL_MATH_H
+#define PEDAL_MATH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Integer pedal math
+// XC8 has no FPU to lean on, so the percentage, discrepancy and BSPD checks
+// use integer intermediates instead of the software float library.
+// Every result is the exact value truncated toward zero, and every compare
+// is exact, so decisions at the thresholds never depend on rounding.
+
+// A sensor's calibration, compiled once when calibration ends
+// Division is the slowest thing the 8-bit core does, so the range is turned
+// into a 16.16 reciprocal and the hot path only multiplies and shifts
+typedef struct {
+    uint16_t min;
+    uint16_t range;         // max - min; 0 until calibrated
+    uint32_t reciprocal;    // (100 << 16) / range, rounded up
+} pedal_scale_t;
+
+void pedal_scale_init(pedal_scale_t* scale, uint16_t min, uint16_t max);
+
+// Percentage of value between the calibrated min and max, clamped to 0..100
+// Returns 0 while the range is empty
+uint8_t pedal_scale_percent(const pedal_scale_t* scale, uint16_t value);
+
+// offset as a percentage of the calibrated range, clamped to 100
+uint8_t pedal_scale_percent_of(const pedal_scale_t* scale, uint16_t offset);
+
+// Readings a sensor may take: its calibrated travel widened by margin on
+// each side and clamped to 0..full_scale. A reading is out of range when it
+// is < lower or > upper, the ADCC's threshold compares. An end clamped to
+// the scale can never be passed and so is not checked: a pot that spans
+// the whole ADC range, as on the breadboard, reads 0 when released and full
+// scale when fully pressed, just like a shorted or open sensor
+typedef struct {
+    uint16_t lower;
+    uint16_t upper;
+} pedal_window_t;
+
+// Before calibration (max < min) the window is the whole scale
+void pedal_window_init(pedal_window_t* window, uint16_t min, uint16_t max, uint16_t margin, uint16_t full_scale);
+
+// True when two percentages are more than limit points apart
+bool pedal_differ(uint8_t percent1, uint8_t percent2, uint8_t limit);
+
+// value compared against percent% of range, e.g. the 25% BSPD throttle limit
+bool pedal_above_percent(uint16_t value, uint16_t range, uint8_t percent);
+bool pedal_below_percent(uint16_t value, uint16_t range, uint8_t percent);
+
+#endif // PEDAL_MATH_H
@@ -0,0 +1,86 @@
+#include "profiler.h"
+#include "log.h"
+
+#if PROFILE_ENABLED
+
+static profile_stats_t profile_stats[PROFILE_SITE_COUNT];
+
+// Site and line the dump sends next; line 0 is the PROFILE_SITE line, then
+// one PROFILE_HIST line per 4 bins. PROFILE_SITE_COUNT when not dumping
+static uint8_t dump_site = PROFILE_SITE_COUNT;
+static uint8_t dump_line = 0;
+
+static void clear_site(profile_stats_t* s) {
+    s->min = 0xFFFF;
+    s->max = 0;
+    s->total = 0;
+    s->count = 0;
+    for (uint8_t i = 0; i < PROFILE_HIST_BINS; i++) {
+        s->hist[i] = 0;
+    }
+}
+
+void profiler_record(uint8_t site, uint16_t counts) {
+    profile_stats_t* s = &profile_stats[site];
+    
+    if (counts < s->min) {
+        s->min = counts;
+    }
+    if (counts > s->max) {
+        s->max = counts;
+    }
+    s->total += counts;
+    s->count++;
+    
+    // Bins grow by 4x, so shift two bits at a time instead of dividing
+    uint8_t bin = 0;
+    while (counts >= 4 && bin < PROFILE_HIST_BINS - 1) {
+        counts >>= 2;
+        bin++;
+    }
+    s->hist[bin]++;
+    
+    if (s->count == 0xFFFF) {
+        // Restart before the mean and histogram overflow
+        clear_site(s);
+    }
+}
+
+void profiler_reset(void) {
+    for (uint8_t site = 0; site < PROFILE_SITE_COUNT; site++) {
+        clear_site(&profile_stats[site]);
+    }
+}
+
+void profiler_dump_start(void) {
+    dump_site = 0;
+    dump_line = 0;
+}
+
+void profiler_dump_run(void) {
+    // Sites that never ran are left out
+    while (dump_line == 0 && dump_site < PROFILE_SITE_COUNT && profile_stats[dump_site].count == 0) {
+        dump_site++;
+    }
+    // One line per call, and only when it fits whole, as the trace dump
+    if (dump_site == PROFILE_SITE_COUNT || !log_can_write()) {
+        return;
+    }
+    
+    // All times in TMR1 counts; site names are on the host
+    profile_stats_t* s = &profile_stats[dump_site];
+    if (dump_line == 0) {
+        LOG_INFO(PROFILE_SITE, dump_site, s->min, s->total / s->count, s->max, s->count);
+    } else {
+        uint8_t i = (uint8_t)((dump_line - 1) * 4);
+        LOG_INFO(PROFILE_HIST, i, s->hist[i], s->hist[i + 1], s->hist[i + 2], s->hist[i + 3]);
+    }
+    
+    dump_line++;
+    if (dump_line > PROFILE_HIST_BINS / 4) {
+        dump_line = 0;
+        dump_site++;
+    }
+}
+
+#endif // PROFILE_ENABLED
@@ -0,0 +1,68 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "mcc_generated_files/mcc.h"
+
+// Execution time profiler
+// Each site records min/max/mean and a histogram of its run time, measured
+// in free-running TMR1 counts (500 kHz MFINTOSC, so 2 us per count at any
+// core clock).
+// Build with PROFILE_ENABLED=1 to turn it on; otherwise every macro below
+// expands to nothing and the profiler costs no flash, RAM or cycles.
+
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED 0
+#endif
+
+// One site per row of the FSM table in main.c, which fails to build if
+// this does not match fsm_row_t; names are in the profile_site table of
+// log_messages.def
+#define PROFILE_FSM_ROWS 11
+
+typedef enum {
+    PROFILE_UPDATE_SENSOR_VALS,
+    PROFILE_HAS_DISCREPANCY,
+    PROFILE_BRAKE_IMPLAUSIBLE,
+    PROFILE_FSM_ROW,    // first of PROFILE_FSM_ROWS sites, indexed by FSM row
+    PROFILE_SITE_COUNT = PROFILE_FSM_ROW + PROFILE_FSM_ROWS
+} profile_site_t;
+
+// Histogram bin i counts runs of 4^i to 4^(i+1) - 1 TMR1 counts; the last
+// bin takes everything longer
+#define PROFILE_HIST_BINS 8
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint32_t total;     // for the mean
+    uint16_t count;
+    uint16_t hist[PROFILE_HIST_BINS];
+} profile_stats_t;
+
+#if PROFILE_ENABLED
+
+#define PROFILE_BEGIN(start) uint16_t start = TMR1_ReadTimer()
+#define PROFILE_END(start, site) profiler_record((site), TMR1_ReadTimer() - (start))
+#define PROFILE_RESET() profiler_reset()
+#define PROFILE_DUMP_START() profiler_dump_start()
+#define PROFILE_DUMP_RUN() profiler_dump_run()
+
+void profiler_record(uint8_t site, uint16_t counts);
+void profiler_reset(void);
+// Starts a dump of every site that has run. The dump is about 360 bytes,
+// more than the UART ring holds, so profiler_dump_run() sends one line per
+// call, from a task, once it fits
+void profiler_dump_start(void);
+void profiler_dump_run(void);
+
+#else
+
+#define PROFILE_BEGIN(start)
+#define PROFILE_END(start, site)
+#define PROFILE_RESET()
+#define PROFILE_DUMP_START()
+#define PROFILE_DUMP_RUN()
+
+#endif // PROFILE_ENABLED
+
+#endif // PROFILER_H
@@ -0,0 +1,57 @@
+#include "scheduler.h"
+#include "tick.h"
+#include "log.h"
+
+void scheduler_init(task_stats_t stats[], uint8_t n_tasks) {
+    uint32_t now = tick_get_ms();
+    
+    for (uint8_t i = 0; i < n_tasks; i++) {
+        stats[i].next_release_ms = now;
+        stats[i].max_us = 0;
+        stats[i].overruns = 0;
+        stats[i].skipped = 0;
+    }
+}
+
+void scheduler_run(const task_t tasks[], task_stats_t stats[], uint8_t n_tasks) {
+    for (uint8_t i = 0; i < n_tasks; i++) {
+        task_stats_t* s = &stats[i];
+        
+        // Signed difference so the comparison survives the ms counter wrapping
+        if ((int32_t)(tick_get_ms() - s->next_release_ms) < 0) {
+            continue;
+        }
+        
+        uint32_t start_us = tick_get_us();
+        tasks[i].run();
+        uint32_t elapsed_us = tick_get_us() - start_us;
+        
+        if (elapsed_us > 0xFFFF) {
+            elapsed_us = 0xFFFF;
+        }
+        if (elapsed_us > s->max_us) {
+            s->max_us = (uint16_t)elapsed_us;
+        }
+        if (elapsed_us > tasks[i].budget_us) {
+            s->overruns++;
+        }
+        
+        // Release on a fixed grid; if we have fallen more than a whole
+        // period behind, drop the missed releases instead of bursting
+        s->next_release_ms += tasks[i].period_ms;
+        while ((int32_t)(tick_get_ms() - s->next_release_ms) >= 0) {
+            s->next_release_ms += tasks[i].period_ms;
+            s->skipped++;
+        }
+    }
+}
+
+void scheduler_print_stats(const task_t tasks[], const task_stats_t stats[], uint8_t index) {
+    // Task names are on the host, by index
+    LOG_INFO(TASK_STATS,
+            index,
+            stats[index].max_us,
+            tasks[index].budget_us,
+            stats[index].overruns,
+            stats[index].skipped);
+}
@@ -0,0 +1,35 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// Cooperative multi-rate scheduler
+// Tasks live in a const table (program memory) ordered by priority. Every
+// tick, each task whose period has elapsed runs to completion, highest
+// priority first.
+
+// Names are only on the host, in the task LOG_TABLE of log_messages.def
+typedef struct {
+    void (*run)(void);
+    uint16_t period_ms;
+    uint16_t budget_us;     // a run longer than this counts as an overrun
+} task_t;
+
+// Per-task run-time state, kept in RAM alongside the const table
+typedef struct {
+    uint32_t next_release_ms;
+    uint16_t max_us;        // longest run seen
+    uint16_t overruns;      // runs that went over budget
+    uint16_t skipped;       // releases missed because the task started late
+} task_stats_t;
+
+void scheduler_init(task_stats_t stats[], uint8_t n_tasks);
+
+// Call once per tick
+void scheduler_run(const task_t tasks[], task_stats_t stats[], uint8_t n_tasks);
+
+// Logs one task's stats; a caller sending them all should pace the calls,
+// see run_housekeeping() in main.c
+void scheduler_print_stats(const task_t tasks[], const task_stats_t stats[], uint8_t index);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,131 @@
+#include "telemetry.h"
+#include "tick.h"
+#include "mcc_generated_files/mcc.h"
+
+#include <string.h>
+
+// CRC-16-CCITT as in tools/telemetry_decode.py
+#define CRC_SEED 0xFFFF
+
+// Encoded size of anything shorter than 254 bytes
+#define COBS_LENGTH(length) ((length) + 1)
+
+telemetry_stats_t telemetry_stats;
+
+static telemetry_samples_frame_t samples_frame;
+static uint8_t sample_count = 0;
+static uint8_t sequence = 0;
+
+// Largest frame plus its CRC
+#define FRAME_MAX_LENGTH ((sizeof(telemetry_samples_frame_t) > sizeof(telemetry_header_t) + TELEMETRY_MAX_PAYLOAD) \
+        ? sizeof(telemetry_samples_frame_t) : sizeof(telemetry_header_t) + TELEMETRY_MAX_PAYLOAD)
+static uint8_t buffer[FRAME_MAX_LENGTH + 2];
+
+static uint16_t crc16(const uint8_t* data, uint8_t length) {
+    CRC_SeedSet(CRC_SEED);
+    CRC_StartCrc();
+    for (uint8_t i = 0; i < length; i++) {
+        while (!CRC_8BitDataWrite(data[i])) {
+        }
+    }
+    while (CRC_IsCrcBusy()) {
+    }
+    return CRC_CalculatedResultGet(false, 0);
+}
+
+// Writes data COBS-encoded; every frame is shorter than one 254-byte block
+// limit, so each code byte is just the distance to the next zero
+static void write_cobs(const uint8_t* data, uint8_t length) {
+    uint8_t block_start = 0;
+    for (uint8_t i = 0; i <= length; i++) {
+        // The end of the data closes the last block without a zero
+        if (i < length && data[i] != 0x00) {
+            continue;
+        }
+        UART1_Write((uint8_t)(i - block_start + 1));
+        for (uint8_t j = block_start; j < i; j++) {
+            UART1_Write(data[j]);
+        }
+        block_start = i + 1;
+    }
+}
+
+// Sends the first length bytes of buffer and their CRC between two 0x00
+// delimiters, or drops them whole
+static void send_buffer(uint8_t length) {
+    uint16_t crc = crc16(buffer, length);
+    buffer[length++] = (uint8_t)crc;
+    buffer[length++] = (uint8_t)(crc >> 8);
+    
+    if (UART1_get_tx_free() < COBS_LENGTH(length) + 2) {
+        telemetry_stats.dropped++;
+        return;
+    }
+    
+    UART1_Write(0x00);
+    write_cobs(buffer, length);
+    UART1_Write(0x00);
+    telemetry_stats.sent++;
+}
+
+static void send_frame(const void* frame, uint8_t length) {
+    memcpy(buffer, frame, length);
+    send_buffer(length);
+}
+
+static void start_frame(telemetry_header_t* header, telemetry_frame_type_t type, uint16_t time_ms) {
+    header->type = type;
+    header->sequence = sequence++;
+    header->time_ms = time_ms;
+}
+
+void telemetry_sample(uint16_t throttle1, uint16_t throttle2, uint16_t brake,
+        uint8_t state, uint8_t error, uint16_t torque) {
+    if (sample_count == 0) {
+        start_frame(&samples_frame.header, TELEMETRY_FRAME_SAMPLES, (uint16_t)tick_get_ms());
+    }
+    
+    telemetry_sample_t* sample = &samples_frame.samples[sample_count];
+    sample->throttle1 = throttle1;
+    sample->throttle2 = throttle2;
+    sample->brake = brake;
+    
+    sample_count++;
+    if (sample_count == TELEMETRY_BATCH) {
+        // Status as of the last sample
+        samples_frame.state = state;
+        samples_frame.error = error;
+        samples_frame.torque = torque;
+        send_frame(&samples_frame, sizeof(samples_frame));
+        sample_count = 0;
+    }
+}
+
+void telemetry_transition(uint8_t from_state, uint8_t from_error, uint8_t to_state, uint8_t to_error) {
+    telemetry_transition_frame_t frame;
+    
+    start_frame(&frame.header, TELEMETRY_FRAME_TRANSITION, (uint16_t)tick_get_ms());
+    frame.from_state = from_state;
+    frame.from_error = from_error;
+    frame.to_state = to_state;
+    frame.to_error = to_error;
+    send_frame(&frame, sizeof(frame));
+}
+
+void telemetry_send(telemetry_frame_type_t type, const uint8_t* payload, uint8_t length) {
+    telemetry_header_t header;
+    
+    if (length > TELEMETRY_MAX_PAYLOAD) {
+        return;
+    }
+    
+    start_frame(&header, type, (uint16_t)tick_get_ms());
+    memcpy(buffer, &header, sizeof(header));
+    memcpy(buffer + sizeof(header), payload, length);
+    send_buffer(sizeof(header) + length);
+}
+
+bool telemetry_can_send(uint8_t length) {
+    // Header and CRC, encoded, between two delimiters as in send_buffer()
+    return UART1_get_tx_free() >= COBS_LENGTH(sizeof(telemetry_header_t) + length + 2) + 2;
+}
@@ -0,0 +1,76 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Binary telemetry frames
+// Samples are batched into packed little-endian frames, protected by a
+// CRC-16-CCITT from the CRC module and COBS-encoded, with a 0x00 on both
+// sides of every frame. Plain text printed between frames still comes
+// through: the decoder shows any chunk that is not a valid frame as text.
+// Frame layouts are mirrored in tools/telemetry_decode.py.
+
+typedef enum {
+    TELEMETRY_FRAME_SAMPLES = 1,
+    TELEMETRY_FRAME_TRANSITION = 2,
+    TELEMETRY_FRAME_LOG = 3,        // level, token and varint arguments, see log.h
+    TELEMETRY_FRAME_TRACE = 4       // trace_frame_t, see trace.h
+} telemetry_frame_type_t;
+
+// Longest payload telemetry_send() takes
+#define TELEMETRY_MAX_PAYLOAD 32
+
+// Samples per TELEMETRY_FRAME_SAMPLES frame
+#define TELEMETRY_BATCH 16
+
+typedef struct {
+    uint16_t throttle1;
+    uint16_t throttle2;
+    uint16_t brake;
+} telemetry_sample_t;
+
+// Every frame starts with this
+typedef struct {
+    uint8_t type;       // telemetry_frame_type_t
+    uint8_t sequence;   // increments per frame sent or dropped, so gaps show
+    uint16_t time_ms;   // tick_get_ms() of the (first) sample, wrapped
+} telemetry_header_t;
+
+typedef struct {
+    telemetry_header_t header;
+    uint8_t state;
+    uint8_t error;
+    uint16_t torque;
+    telemetry_sample_t samples[TELEMETRY_BATCH];
+} telemetry_samples_frame_t;
+
+typedef struct {
+    telemetry_header_t header;
+    uint8_t from_state;
+    uint8_t from_error;
+    uint8_t to_state;
+    uint8_t to_error;
+} telemetry_transition_frame_t;
+
+typedef struct {
+    uint16_t sent;
+    uint16_t dropped;   // whole frames skipped because the UART ring was full
+} telemetry_stats_t;
+
+extern telemetry_stats_t telemetry_stats;
+
+// Adds one sample with the current status; sends a frame every TELEMETRY_BATCH calls
+void telemetry_sample(uint16_t throttle1, uint16_t throttle2, uint16_t brake,
+        uint8_t state, uint8_t error, uint16_t torque);
+
+// Sends a transition frame straight away
+void telemetry_transition(uint8_t from_state, uint8_t from_error, uint8_t to_state, uint8_t to_error);
+
+// Sends a frame of the given type with a header and an arbitrary payload
+void telemetry_send(telemetry_frame_type_t type, const uint8_t* payload, uint8_t length);
+
+// Whether a telemetry_send() of length bytes would fit in the UART ring now
+bool telemetry_can_send(uint8_t length);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,147 @@
+#include "fake_ecan.h"
+#include "tick.h"
+
+#include <string.h>
+
+volatile PIE5bits_t PIE5bits;
+
+uint32_t sim_now_us;
+uint32_t sim_frame_us;
+sim_frame_t sim_log[SIM_LOG_SIZE];
+uint16_t sim_sent;
+uint16_t sim_aborted;
+
+static struct {
+    bool pending;
+    bool flag;
+    uint8_t priority;
+    uCAN_MSG msg;
+    void (*handler)(uint8_t buffer);
+} buffers[ECAN_TX_BUFFER_COUNT];
+
+static int8_t on_wire;
+static uint32_t wire_end_us;
+static uint32_t busy_until_us;
+
+static bool interrupt_enabled(uint8_t buffer) {
+    return buffer == 0 ? PIE5bits.TXB0IE : buffer == 1 ? PIE5bits.TXB1IE : PIE5bits.TXB2IE;
+}
+
+static void run_interrupts(void) {
+    for (uint8_t buffer = 0; buffer < ECAN_TX_BUFFER_COUNT; buffer++) {
+        if (buffers[buffer].flag && interrupt_enabled(buffer)) {
+            buffers[buffer].flag = false;
+            if (buffers[buffer].handler != NULL) {
+                buffers[buffer].handler(buffer);
+            }
+        }
+    }
+}
+
+static int8_t next_buffer(void) {
+    int8_t next = -1;
+
+    for (uint8_t buffer = 0; buffer < ECAN_TX_BUFFER_COUNT; buffer++) {
+        if (buffers[buffer].pending && (next < 0 || buffers[buffer].priority >= buffers[next].priority)) {
+            next = (int8_t)buffer;
+        }
+    }
+    return next;
+}
+
+void sim_reset(void) {
+    memset(buffers, 0, sizeof(buffers));
+    memset(sim_log, 0, sizeof(sim_log));
+    PIE5bits.TXB0IE = 1;
+    PIE5bits.TXB1IE = 1;
+    PIE5bits.TXB2IE = 1;
+    sim_now_us = 0;
+    sim_frame_us = 270;
+    sim_sent = 0;
+    sim_aborted = 0;
+    on_wire = -1;
+    busy_until_us = 0;
+}
+
+void sim_advance(uint32_t us) {
+    uint32_t end_us = sim_now_us + us;
+
+    run_interrupts();
+    while (1) {
+        if (on_wire >= 0) {
+            if (wire_end_us > end_us) {
+                break;
+            }
+            sim_now_us = wire_end_us;
+            sim_frame_t* frame = &sim_log[sim_sent % SIM_LOG_SIZE];
+            frame->msg = buffers[on_wire].msg;
+            frame->buffer = (uint8_t)on_wire;
+            frame->end_us = sim_now_us;
+            sim_sent++;
+            buffers[on_wire].pending = false;
+            buffers[on_wire].flag = true;
+            on_wire = -1;
+            run_interrupts();
+            continue;
+        }
+        uint32_t start_us = busy_until_us > sim_now_us ? busy_until_us : sim_now_us;
+        int8_t next = next_buffer();
+        if (next < 0 || start_us > end_us) {
+            break;
+        }
+        sim_now_us = start_us;
+        on_wire = next;
+        wire_end_us = start_us + sim_frame_us;
+    }
+    sim_now_us = end_us;
+}
+
+void sim_bus_busy(uint32_t us) {
+    busy_until_us = sim_now_us + us;
+}
+
+const sim_frame_t* sim_last(uint16_t n) {
+    return &sim_log[(uint16_t)(sim_sent - 1 - n) % SIM_LOG_SIZE];
+}
+
+// Driver
+
+uint8_t CAN_transmitBuffer(uint8_t buffer, uCAN_MSG* msg) {
+    if (buffers[buffer].pending) {
+        return 0;
+    }
+    buffers[buffer].msg = *msg;
+    buffers[buffer].pending = true;
+    return 1;
+}
+
+uint8_t CAN_isTXBufferPending(uint8_t buffer) {
+    return buffers[buffer].pending;
+}
+
+void CAN_abortTransmitBuffer(uint8_t buffer) {
+    // One on the wire finishes regardless
+    if (buffers[buffer].pending && on_wire != (int8_t)buffer) {
+        buffers[buffer].pending = false;
+        sim_aborted++;
+    }
+}
+
+void ECAN_SetTXBnPriority(uint8_t buffer, uint8_t priority) {
+    buffers[buffer].priority = priority & 0x03;
+}
+
+void ECAN_SetTXBnInterruptHandler(uint8_t buffer, void (*handler)(uint8_t buffer)) {
+    buffers[buffer].handler = handler;
+}
+
+// Tick
+
+uint32_t tick_get_us(void) {
+    sim_advance(1);
+    return sim_now_us;
+}
+
+uint32_t tick_get_us_isr(void) {
+    return sim_now_us;
+}
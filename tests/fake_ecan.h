@@ -0,0 +1,49 @@
+#ifndef FAKE_ECAN_H
+#define FAKE_ECAN_H
+
+#include "mcc_generated_files/mcc.h"
+
+// Loopback stand-in for the ECAN driver and the tick, for host tests
+// Simulated time only moves in sim_advance(), and by 1 us per
+// tick_get_us() call so busy-waits end. The bus sends one frame at a time
+// from the pending TX buffer with the highest TXPRI (the higher-numbered
+// one on a tie), takes sim_frame_us per frame, and then raises that
+// buffer's TX interrupt, which runs the registered handler once its PIE5
+// enable bit is set.
+
+#define SIM_LOG_SIZE 64
+
+typedef struct {
+    uCAN_MSG msg;
+    uint8_t buffer;
+    uint32_t end_us;
+} sim_frame_t;
+
+extern uint32_t sim_now_us;
+extern uint32_t sim_frame_us;
+
+// Frames acknowledged on the bus, the last SIM_LOG_SIZE of them
+extern sim_frame_t sim_log[SIM_LOG_SIZE];
+extern uint16_t sim_sent;
+// Messages dropped by an abort before they got on the bus
+extern uint16_t sim_aborted;
+
+void sim_reset(void);
+
+// Runs the bus and the TX interrupts for us microseconds
+void sim_advance(uint32_t us);
+
+// Other nodes win the bus for the next us microseconds
+void sim_bus_busy(uint32_t us);
+
+// The nth last frame sent, 0 being the latest
+const sim_frame_t* sim_last(uint16_t n);
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition); \
+            return 1; \
+        } \
+    } while (0)
+
+#endif // FAKE_ECAN_H
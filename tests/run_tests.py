@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Run the host tests.
+
+    python3 tests/run_tests.py            # everything
+    python3 tests/run_tests.py can_tx     # only tests whose name contains can_tx
+
+Python tests are test_*.py unittest modules. C tests are test_*.c programs
+that exit non-zero on failure; each names the firmware sources it links in
+a "// sources:" line. They are built with the host gcc against stub/, which
+stands in for xc.h and the registers the tested modules touch, so only
+modules that keep their hardware access behind the MCC drivers (or a few
+interrupt-enable bits) can be tested here.
+"""
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import unittest
+
+TESTS = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(TESTS)
+CFLAGS = ["-std=gnu99", "-O2", "-Wall", "-Wextra", "-Wno-unused-parameter", "-Wno-unknown-pragmas"]
+
+
+def run_c_test(path, build):
+    with open(path) as f:
+        match = re.search(r"^// sources:(.*)$", f.read(), re.M)
+    sources = [os.path.join(ROOT, name) for name in (match.group(1).split() if match else [])]
+    binary = os.path.join(build, os.path.splitext(os.path.basename(path))[0])
+    command = ["gcc"] + CFLAGS + ["-I" + os.path.join(TESTS, "stub"), "-I" + ROOT,
+                                  "-o", binary, path] + sources + ["-lm"]
+    if subprocess.run(command).returncode != 0:
+        return False
+    return subprocess.run([binary]).returncode == 0
+
+
+def main():
+    pattern = sys.argv[1] if len(sys.argv) > 1 else ""
+    names = sorted(name for name in os.listdir(TESTS) if name.startswith("test_") and pattern in name)
+    failed = []
+
+    sys.path.insert(0, TESTS)
+    python_tests = [name[:-3] for name in names if name.endswith(".py")]
+    if python_tests:
+        suite = unittest.defaultTestLoader.loadTestsFromNames(python_tests)
+        if not unittest.TextTestRunner(verbosity=1).run(suite).wasSuccessful():
+            failed.append("python tests")
+
+    with tempfile.TemporaryDirectory() as build:
+        for name in names:
+            if name.endswith(".c"):
+                print("%s:" % name, flush=True)
+                if not run_c_test(os.path.join(TESTS, name), build):
+                    failed.append(name)
+
+    if failed:
+        sys.exit("FAILED: " + ", ".join(failed))
+    print("all tests passed")
+
+
+if __name__ == "__main__":
+    main()
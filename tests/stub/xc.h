@@ -0,0 +1,33 @@
+#ifndef XC_H
+#define XC_H
+
+// Host stand-in for XC8's xc.h: the compiler extensions the MCC headers
+// use, and only the registers of the modules under test. Add a register
+// here when a test needs it.
+
+#include <stdint.h>
+
+typedef uint32_t __uint24;
+
+#define __interrupt(...)
+#define __at(address)
+#define __section(name)
+#define __persistent
+#define __far
+#define __delay_ms(ms) ((void)(ms))
+#define __delay_us(us) ((void)(us))
+#define NOP() ((void)0)
+#define CLRWDT() ((void)0)
+#define di() ((void)0)
+#define ei() ((void)0)
+
+typedef struct {
+    unsigned TXB0IE : 1;
+    unsigned TXB1IE : 1;
+    unsigned TXB2IE : 1;
+    unsigned RXB0IE : 1;
+    unsigned RXB1IE : 1;
+} PIE5bits_t;
+extern volatile PIE5bits_t PIE5bits;
+
+#endif // XC_H
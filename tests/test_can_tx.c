@@ -0,0 +1,172 @@
+// Latest-value CAN TX slots against the loopback bus
+// sources: can_tx.c tests/fake_ecan.c
+
+#include "fake_ecan.h"
+#include "can_tx.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static void queue(uint32_t id, uint8_t value) {
+    uCAN_MSG msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.frame.idType = dSTANDARD_CAN_MSG_ID_2_0B;
+    msg.frame.id = id;
+    msg.frame.dlc = 1;
+    msg.frame.data0 = value;
+    can_tx_queue(&msg, sim_now_us);
+}
+
+static void start(void) {
+    sim_reset();
+    can_tx_init();
+}
+
+// The nth frame sent since start(), 0 being the first
+static const sim_frame_t* sent(uint16_t n) {
+    return sim_last((uint16_t)(sim_sent - 1 - n));
+}
+
+static int test_idle_bus(void) {
+    can_tx_stats_t stats;
+
+    start();
+    queue(0x100, 1);
+    queue(0x101, 2);
+    sim_advance(1000);
+    can_tx_get_stats(&stats);
+
+    CHECK(sim_sent == 2);
+    CHECK(stats.sent == 2);
+    CHECK(stats.replaced == 0 && stats.dropped == 0);
+    // Never TXB0, which belongs to the torque command
+    CHECK(sent(0)->buffer != 0 && sent(1)->buffer != 0);
+    CHECK(stats.latency_max_us == 2 * 270);
+    return 0;
+}
+
+static int test_newest_value_replaces(void) {
+    can_tx_stats_t stats;
+
+    start();
+    sim_bus_busy(5000);
+    // The first of each goes into a hardware buffer, the rest wait in the slots
+    for (uint8_t i = 1; i <= 5; i++) {
+        queue(0x100, i);
+        queue(0x101, (uint8_t)(10 + i));
+    }
+    sim_advance(10000);
+    can_tx_get_stats(&stats);
+
+    // 2 loaded, then 3 + 3 overwritten before the bus came free, so each ID
+    // goes out twice: what was loaded, then only its newest value
+    CHECK(stats.replaced == 6);
+    CHECK(sim_sent == 4);
+    CHECK(sent(0)->msg.frame.id == 0x100 && sent(0)->msg.frame.data0 == 1);
+    CHECK(sent(1)->msg.frame.id == 0x100 && sent(1)->msg.frame.data0 == 5);
+    CHECK(sent(2)->msg.frame.id == 0x101 && sent(2)->msg.frame.data0 == 11);
+    CHECK(sent(3)->msg.frame.id == 0x101 && sent(3)->msg.frame.data0 == 15);
+    return 0;
+}
+
+static int test_priority_order(void) {
+    start();
+    sim_bus_busy(5000);
+    queue(0x300, 0);
+    queue(0x200, 0);
+    queue(0x250, 0);
+    queue(0x050, 0);
+    sim_advance(10000);
+
+    CHECK(sim_sent == 4);
+    // 0x300 and 0x200 were loaded first, but the TX interrupt refills the
+    // freed buffer with a TXPRI that puts the waiting IDs ahead of 0x300
+    CHECK(sent(0)->msg.frame.id == 0x200);
+    CHECK(sent(1)->msg.frame.id == 0x050);
+    CHECK(sent(2)->msg.frame.id == 0x250);
+    CHECK(sent(3)->msg.frame.id == 0x300);
+    return 0;
+}
+
+static int test_standard_beats_extended(void) {
+    uCAN_MSG msg;
+
+    start();
+    sim_bus_busy(5000);
+    queue(0x400, 0);
+    queue(0x401, 0);
+    memset(&msg, 0, sizeof(msg));
+    msg.frame.idType = dEXTENDED_CAN_MSG_ID_2_0B;
+    msg.frame.id = (0x100UL << 18) | 1;
+    can_tx_queue(&msg, sim_now_us);
+    queue(0x100, 0);
+    sim_advance(10000);
+
+    CHECK(sim_sent == 4);
+    CHECK(sent(0)->msg.frame.id == 0x400);
+    CHECK(sent(1)->msg.frame.idType == dSTANDARD_CAN_MSG_ID_2_0B && sent(1)->msg.frame.id == 0x100);
+    CHECK(sent(2)->msg.frame.idType == dEXTENDED_CAN_MSG_ID_2_0B);
+    CHECK(sent(3)->msg.frame.id == 0x401);
+    return 0;
+}
+
+static int test_drop_without_slot(void) {
+    can_tx_stats_t stats;
+
+    start();
+    for (uint32_t id = 0x100; id < 0x100 + CAN_TX_SLOT_COUNT + 1; id++) {
+        queue(id, 0);
+    }
+    sim_advance(10000);
+    can_tx_get_stats(&stats);
+
+    CHECK(stats.dropped == 1);
+    CHECK(sim_sent == CAN_TX_SLOT_COUNT);
+    return 0;
+}
+
+// Other nodes take 85% of the bus, leaving room for 5 frames a period, and
+// both IDs are queued 5 times a period, twice what the bus can drain; the
+// slots must coalesce to the newest value, and latency must stay bounded,
+// not grow
+static int test_overload_latency_bounded(void) {
+    can_tx_stats_t stats;
+    uint8_t value = 0;
+
+    start();
+    for (int period = 0; period < 1000; period++) {
+        sim_bus_busy(8500);
+        for (int i = 0; i < 5; i++) {
+            value++;
+            queue(0x100, value);
+            queue(0x101, value);
+            sim_advance(1000);
+        }
+        sim_advance(5000);
+    }
+    sim_advance(10000);
+    can_tx_get_stats(&stats);
+
+    printf("  overload: sent %u, replaced %u, max latency %lu us\n",
+           stats.sent, stats.replaced, (unsigned long)stats.latency_max_us);
+    // Each ID goes out with what was loaded at the start of the period and
+    // then with its newest value; the 3 values in between are replaced
+    CHECK(stats.sent == 4000);
+    CHECK(stats.replaced == 6000);
+    CHECK(stats.latency_max_us <= 8500 + 4 * 270);
+    // The last frame of each ID carries the last value queued
+    CHECK(sim_last(2)->msg.frame.id == 0x100 && sim_last(2)->msg.frame.data0 == value);
+    CHECK(sim_last(0)->msg.frame.id == 0x101 && sim_last(0)->msg.frame.data0 == value);
+    return 0;
+}
+
+int main(void) {
+    int failed = test_idle_bus()
+        | test_newest_value_replaces()
+        | test_priority_order()
+        | test_standard_beats_extended()
+        | test_drop_without_slot()
+        | test_overload_latency_bounded();
+    return failed;
+}
@@ -0,0 +1,158 @@
+// Integer pedal math against the 32-bit float code it replaced
+// sources: pedal_math.c
+//
+// XC8's double is 32 bits on this part, so the baseline's
+// (uint16_t)(((double)offset / range) * 100) is reproduced with float.
+// The integer path must equal the exact truncated percentage everywhere;
+// float may only differ where the exact value is a whole number and float
+// rounding lands just under it.
+
+#include "pedal_math.h"
+#include "adc_scan.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition); \
+            return 1; \
+        } \
+    } while (0)
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+} calibration_t;
+
+// 12-bit extremes; each is also run scaled to ADC_RESULT_BITS
+static const calibration_t CALIBRATIONS[] = {
+    { 0, 4095 },
+    { 0, 1 },
+    { 0, 2 },
+    { 0, 3 },
+    { 4094, 4095 },
+    { 4000, 4095 },
+    { 1, 4094 },
+    { 100, 4000 },
+    { 1234, 3210 },
+    { 2047, 2048 },
+    { 0, 100 },
+    { 0, 99 },
+    { 0, 101 },
+    { 4095, 4095 },     // not calibrated
+};
+#define CALIBRATION_COUNT (sizeof(CALIBRATIONS) / sizeof(CALIBRATIONS[0]))
+
+static uint8_t float_percent(uint16_t min, uint16_t max, uint16_t value) {
+    if (value > max) {
+        value = max;
+    }
+    else if (value < min) {
+        value = min;
+    }
+    return (uint8_t)(((float)(value - min) / (float)(max - min)) * 100);
+}
+
+static uint8_t exact_percent(uint16_t min, uint16_t max, uint16_t value) {
+    if (value > max) {
+        value = max;
+    }
+    else if (value < min) {
+        value = min;
+    }
+    return (uint8_t)((uint32_t)(value - min) * 100 / (max - min));
+}
+
+static unsigned float_differences = 0;
+
+static int check_calibration(uint16_t min, uint16_t max, uint16_t top) {
+    pedal_scale_t scale;
+
+    pedal_scale_init(&scale, min, max);
+    for (uint32_t value = 0; value <= top; value++) {
+        uint8_t percent = pedal_scale_percent(&scale, (uint16_t)value);
+
+        if (max <= min) {
+            CHECK(percent == 0);
+            continue;
+        }
+        uint8_t exact = exact_percent(min, max, (uint16_t)value);
+        if (percent != exact) {
+            printf("min %u max %u value %u: %u, exact %u\n", min, max, (unsigned)value, percent, exact);
+            return 1;
+        }
+        uint8_t rounded = float_percent(min, max, (uint16_t)value);
+        if (rounded != exact) {
+            uint16_t clamped = value > max ? max : value < min ? min : (uint16_t)value;
+            CHECK(rounded == exact - 1);
+            CHECK((uint32_t)(clamped - min) * 100 % (max - min) == 0);
+            float_differences++;
+        }
+    }
+    return 0;
+}
+
+static int test_percent(void) {
+    for (unsigned i = 0; i < CALIBRATION_COUNT; i++) {
+        const calibration_t* c = &CALIBRATIONS[i];
+        if (check_calibration(c->min, c->max, 4095)
+            || check_calibration((uint16_t)(c->min << ADC_EXTRA_BITS), (uint16_t)(c->max << ADC_EXTRA_BITS), ADC_RESULT_MAX)) {
+            return 1;
+        }
+    }
+    printf("  percent: integer exact everywhere; 32-bit float one low in %u cases\n", float_differences);
+    return 0;
+}
+
+// The BSPD limit was value > range * 0.25 in float
+static int test_bspd(void) {
+    for (unsigned i = 0; i < CALIBRATION_COUNT; i++) {
+        uint16_t range = (uint16_t)((CALIBRATIONS[i].max - CALIBRATIONS[i].min) << ADC_EXTRA_BITS);
+        for (uint32_t value = 0; value <= ADC_RESULT_MAX; value++) {
+            CHECK(pedal_above_percent((uint16_t)value, range, 25) == (value > range * 0.25f));
+            CHECK(pedal_below_percent((uint16_t)value, range, 25) == (value < range * 0.25f));
+        }
+    }
+    return 0;
+}
+
+static double elapsed_ns(const struct timespec* start) {
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start->tv_sec) * 1e9 + (double)(end.tv_nsec - start->tv_nsec);
+}
+
+// Host numbers only; the core has no FPU, which is what made float slow.
+// The target figures (cycles per call from the MPLAB simulator stopwatch
+// and program size from the XC8 map file) are not measured here
+static void bench(void) {
+    pedal_scale_t scale;
+    struct timespec start;
+    volatile uint32_t sink = 0;
+    const uint32_t rounds = 2000;
+
+    pedal_scale_init(&scale, 400, 15000);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t round = 0; round < rounds; round++) {
+        for (uint16_t value = 0; value < 4096; value++) {
+            sink += pedal_scale_percent(&scale, (uint16_t)(value << ADC_EXTRA_BITS));
+        }
+    }
+    double integer_ns = elapsed_ns(&start) / (rounds * 4096.0);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint32_t round = 0; round < rounds; round++) {
+        for (uint16_t value = 0; value < 4096; value++) {
+            sink += float_percent(400, 15000, (uint16_t)(value << ADC_EXTRA_BITS));
+        }
+    }
+    double float_ns = elapsed_ns(&start) / (rounds * 4096.0);
+    printf("  host bench: integer %.2f ns, float %.2f ns per percentage (not target cycles)\n", integer_ns, float_ns);
+}
+
+int main(void) {
+    int failed = test_percent() | test_bspd();
+    bench();
+    return failed;
+}
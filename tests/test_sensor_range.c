@@ -0,0 +1,133 @@
+// Out-of-range windows from the pedal calibration
+// sources: pedal_math.c
+//
+// Mirrors init_sensor_thresholds() in main.c and the ADCC's compares: a
+// reading is out of range when it is < lower or > upper.
+
+#include "pedal_math.h"
+#include "adc_scan.h"
+
+#include <stdio.h>
+
+#define CHECK(condition) do { \
+        if (!(condition)) { \
+            printf("%s:%d: failed: %s\n", __FILE__, __LINE__, #condition); \
+            return 1; \
+        } \
+    } while (0)
+
+// SENSOR_RANGE_MARGIN's default
+#define MARGIN (20 << ADC_EXTRA_BITS)
+#define PEDAL_MAX ADC_RESULT_MAX
+
+// ADC noise on a held pedal, in counts at ADC_RESULT_BITS
+#define NOISE (8 << ADC_EXTRA_BITS)
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+} calibration_t;
+
+static bool out_of_range(const pedal_window_t* window, uint16_t value) {
+    return value < window->lower || value > window->upper;
+}
+
+// As run_calibration() does in LV while the pedal is swept from min to max
+static void calibrate(calibration_t* calibration, uint16_t from, uint16_t to) {
+    calibration->min = 0x7FFF;
+    calibration->max = 0;
+    for (uint32_t value = from; value <= to; value += 7) {
+        if (value > calibration->max) {
+            calibration->max = (uint16_t)value;
+        }
+        if (value < calibration->min) {
+            calibration->min = (uint16_t)value;
+        }
+    }
+    if (to > calibration->max) {
+        calibration->max = to;
+    }
+}
+
+static uint16_t clamp(int32_t value) {
+    return value < 0 ? 0 : value > (int32_t)PEDAL_MAX ? PEDAL_MAX : (uint16_t)value;
+}
+
+// The README's breadboard: pots span the whole ADC range, released reads 0
+static int test_breadboard_pedals_held(void) {
+    calibration_t throttle;
+    calibration_t brake;
+    pedal_window_t throttle_window;
+    pedal_window_t brake_window;
+
+    calibrate(&throttle, 0, PEDAL_MAX);
+    calibrate(&brake, 0, PEDAL_MAX);
+    pedal_window_init(&throttle_window, throttle.min, throttle.max, MARGIN, PEDAL_MAX);
+    pedal_window_init(&brake_window, brake.min, brake.max, MARGIN, PEDAL_MAX);
+
+    for (int32_t noise = -NOISE; noise <= NOISE; noise++) {
+        // Released throttle, full throttle, released brake
+        CHECK(!out_of_range(&throttle_window, clamp(noise)));
+        CHECK(!out_of_range(&throttle_window, clamp(PEDAL_MAX + noise)));
+        // The brake only has a lower limit
+        CHECK(clamp(noise) >= brake_window.lower);
+    }
+    // And everything in between
+    for (uint16_t value = 0; value <= PEDAL_MAX; value++) {
+        CHECK(!out_of_range(&throttle_window, value));
+    }
+    return 0;
+}
+
+// Pots that stop short of the rails still catch a shorted or open sensor
+static int test_pedal_box_clear_of_rails(void) {
+    calibration_t throttle;
+    pedal_window_t window;
+
+    calibrate(&throttle, 2000, 14000);
+    pedal_window_init(&window, throttle.min, throttle.max, MARGIN, PEDAL_MAX);
+
+    for (int32_t noise = -NOISE; noise <= NOISE; noise++) {
+        CHECK(!out_of_range(&window, clamp(throttle.min + noise)));
+        CHECK(!out_of_range(&window, clamp(throttle.max + noise)));
+    }
+    CHECK(!out_of_range(&window, throttle.min - MARGIN));
+    CHECK(out_of_range(&window, throttle.min - MARGIN - 1));
+    CHECK(!out_of_range(&window, throttle.max + MARGIN));
+    CHECK(out_of_range(&window, throttle.max + MARGIN + 1));
+    CHECK(out_of_range(&window, 0));
+    CHECK(out_of_range(&window, PEDAL_MAX));
+    return 0;
+}
+
+// Within the margin of a rail, that end is left unchecked
+static int test_near_rail(void) {
+    pedal_window_t window;
+
+    pedal_window_init(&window, MARGIN / 2, PEDAL_MAX - MARGIN / 2, MARGIN, PEDAL_MAX);
+    CHECK(window.lower == 0 && window.upper == PEDAL_MAX);
+    pedal_window_init(&window, MARGIN, PEDAL_MAX - MARGIN, MARGIN, PEDAL_MAX);
+    CHECK(window.lower == 0 && window.upper == PEDAL_MAX);
+    pedal_window_init(&window, MARGIN + 1, PEDAL_MAX - MARGIN - 1, MARGIN, PEDAL_MAX);
+    CHECK(window.lower == 1 && window.upper == PEDAL_MAX - 1);
+    return 0;
+}
+
+// Before the first calibration ends nothing is out of range
+static int test_not_calibrated(void) {
+    pedal_window_t window;
+
+    pedal_window_init(&window, 0x7FFF, 0, MARGIN, PEDAL_MAX);
+    for (uint16_t value = 0; value <= PEDAL_MAX; value++) {
+        CHECK(!out_of_range(&window, value));
+    }
+    return 0;
+}
+
+int main(void) {
+    int failed = test_breadboard_pedals_held()
+        | test_pedal_box_clear_of_rails()
+        | test_near_rail()
+        | test_not_calibrated();
+    return failed;
+}
@@ -0,0 +1,77 @@
+import os
+import struct
+import sys
+import unittest
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "tools"))
+
+import telemetry_decode as telemetry
+import telemetry_record
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for byte in data:
+        if byte == 0:
+            out += bytes([len(block) + 1]) + block
+            block = bytearray()
+        else:
+            block.append(byte)
+            if len(block) == 0xFE:
+                out += bytes([0xFF]) + block
+                block = bytearray()
+    out += bytes([len(block) + 1]) + block
+    return bytes(out)
+
+
+def frame(frame_type, sequence, time_ms, payload):
+    body = telemetry.HEADER.pack(frame_type, sequence, time_ms & 0xFFFF) + payload
+    return cobs_encode(body + struct.pack("<H", telemetry.crc16(body))) + b"\x00"
+
+
+class ListWriter:
+    def __init__(self):
+        self.rows = {}
+
+    def add(self, table, row):
+        self.rows.setdefault(table, []).append(row)
+
+
+class RecorderTest(unittest.TestCase):
+    def record(self, times):
+        writer = ListWriter()
+        recorder = telemetry_record.Recorder(writer, None)
+        payload = telemetry.TRANSITION.pack(0, 0, 1, 0)
+        recorder.feed(b"".join(frame(telemetry.FRAME_TRANSITION, sequence, time_ms, payload)
+                               for sequence, time_ms in enumerate(times)))
+        self.assertEqual(recorder.bad, 0)
+        return [row[0] for row in writer.rows["transitions"]]
+
+    def test_in_order(self):
+        self.assertEqual(self.record([1000, 1030, 1080]), [1000, 1030, 1080])
+
+    def test_older_frame_steps_back(self):
+        # A sample frame stamped before the transition sent ahead of it
+        self.assertEqual(self.record([1000, 1030, 1000, 1080]), [1000, 1030, 1000, 1080])
+
+    def test_wraps_forward(self):
+        self.assertEqual(self.record([65500, 65530, 20, 100]), [65500, 65530, 65556, 65636])
+
+    def test_older_frame_across_wrap(self):
+        self.assertEqual(self.record([65530, 10, 65520, 40]), [65530, 65546, 65520, 65576])
+
+    def test_sample_rows_follow_frame_time(self):
+        writer = ListWriter()
+        recorder = telemetry_record.Recorder(writer, None)
+        samples = telemetry.SAMPLES.pack(*([0] * (3 + 3 * telemetry.TELEMETRY_BATCH)))
+        transition = telemetry.TRANSITION.pack(0, 0, 1, 0)
+        recorder.feed(frame(telemetry.FRAME_TRANSITION, 0, 2000, transition)
+                      + frame(telemetry.FRAME_SAMPLES, 1, 1930, samples))
+        times = [row[0] for row in writer.rows["samples"]]
+        self.assertEqual(times, [1930 + i * telemetry_record.SAMPLE_PERIOD_MS
+                                 for i in range(telemetry.TELEMETRY_BATCH)])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,158 @@
+// Torque command stream against the loopback bus, plus a latency bench
+// sources: torque_cmd.c tests/fake_ecan.c
+
+#include "fake_ecan.h"
+#include "torque_cmd.h"
+#include "torque_map.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PERIOD_US (TORQUE_CMD_PERIOD_MS * 1000UL)
+
+static inverter_command_t last_command(void) {
+    inverter_command_t command;
+    inverter_command_unpack(&sim_last(0)->msg, &command);
+    return command;
+}
+
+static void start(void) {
+    sim_reset();
+    torque_cmd_init();
+}
+
+static int test_idle_bus(void) {
+    torque_cmd_stats_t stats;
+
+    start();
+    for (int i = 0; i < 10; i++) {
+        // The scan finished 1.5 ms before the task ran
+        sim_advance(PERIOD_US);
+        torque_cmd_send(TORQUE_MAX / 2, true, sim_now_us - 1500);
+    }
+    sim_advance(PERIOD_US);
+    torque_cmd_get_stats(&stats);
+
+    CHECK(sim_sent == 10);
+    CHECK(stats.sent == 10);
+    CHECK(stats.aborted == 0 && stats.stale == 0 && stats.over_budget == 0);
+    CHECK(last_command().torque_command == TORQUE_CMD_FULL_SCALE_DNM / 2);
+    CHECK(last_command().inverter_enable == 1);
+    // 1.5 ms + the 1 us read of the clock + one frame
+    CHECK(stats.age_max_us == 1500 + 1 + 270);
+    CHECK(stats.age_bins[1] == 10);
+    return 0;
+}
+
+static int test_enable_frame_never_late(void) {
+    torque_cmd_stats_t stats;
+
+    start();
+    // Other nodes hold the bus past the next period
+    sim_bus_busy(3 * PERIOD_US);
+    torque_cmd_send(TORQUE_MAX, true, sim_now_us);
+    sim_advance(PERIOD_US);
+    // The FSM has left DRIVE
+    torque_cmd_send(0, false, sim_now_us);
+    sim_advance(3 * PERIOD_US);
+    torque_cmd_get_stats(&stats);
+
+    CHECK(sim_aborted == 1);
+    CHECK(stats.aborted == 1);
+    CHECK(sim_sent == 1);
+    CHECK(last_command().inverter_enable == 0);
+    CHECK(last_command().torque_command == 0);
+    return 0;
+}
+
+static int test_frame_on_wire_finishes(void) {
+    torque_cmd_stats_t stats;
+
+    start();
+    // The frame gets on the bus 100 us before the next period
+    sim_bus_busy(PERIOD_US - 100);
+    torque_cmd_send(TORQUE_MAX, true, sim_now_us);
+    sim_advance(PERIOD_US);
+    uint32_t send_us = sim_now_us;
+    torque_cmd_send(TORQUE_MAX / 4, true, sim_now_us);
+    uint32_t wait_us = sim_now_us - send_us;
+    sim_advance(PERIOD_US);
+    torque_cmd_get_stats(&stats);
+
+    // Waited for the first to finish, then sent the new one
+    CHECK(wait_us <= TORQUE_CMD_ABORT_WAIT_US);
+    CHECK(sim_aborted == 0);
+    CHECK(sim_sent == 2);
+    CHECK(stats.sent == 2);
+    CHECK(last_command().torque_command == TORQUE_CMD_FULL_SCALE_DNM / 4);
+    return 0;
+}
+
+static int test_stale_data_zero_torque(void) {
+    torque_cmd_stats_t stats;
+
+    start();
+    sim_advance(10 * PERIOD_US);
+    torque_cmd_send(TORQUE_MAX, true, sim_now_us - TORQUE_CMD_BUDGET_US - 1);
+    sim_advance(PERIOD_US);
+    torque_cmd_get_stats(&stats);
+
+    CHECK(stats.stale == 1);
+    CHECK(last_command().torque_command == 0);
+    // Still counted against the budget on the wire
+    CHECK(stats.over_budget == 1);
+    CHECK(stats.age_bins[TORQUE_CMD_AGE_BINS - 1] == 1);
+    return 0;
+}
+
+static int test_over_budget(void) {
+    torque_cmd_stats_t stats;
+
+    start();
+    sim_advance(10 * PERIOD_US);
+    sim_bus_busy(500);
+    torque_cmd_send(TORQUE_MAX, true, sim_now_us - 3900);
+    sim_advance(PERIOD_US);
+    torque_cmd_get_stats(&stats);
+
+    CHECK(stats.stale == 0);
+    CHECK(stats.over_budget == 1);
+    CHECK(stats.age_max_us > TORQUE_CMD_BUDGET_US);
+    CHECK(stats.age_bins[TORQUE_CMD_AGE_BINS - 1] == 1);
+    return 0;
+}
+
+// Random scan phase and up to 1.5 ms of other traffic ahead of every frame
+static int bench_latency(void) {
+    torque_cmd_stats_t stats;
+    const int periods = 50000;  // the counters are 16 bits
+
+    start();
+    srand(1);
+    for (int i = 0; i < periods; i++) {
+        sim_advance(PERIOD_US);
+        sim_bus_busy((uint32_t)(rand() % 1500));
+        torque_cmd_send(TORQUE_MAX, true, sim_now_us - (uint32_t)(rand() % PERIOD_US));
+    }
+    sim_advance(PERIOD_US);
+    torque_cmd_get_stats(&stats);
+
+    printf("  bench: %d periods, sent %u, aborted %u, over budget %u, max age %lu us\n",
+           periods, stats.sent, stats.aborted, stats.over_budget, (unsigned long)stats.age_max_us);
+    printf("  ages 0-1/1-2/2-3/3-4/4+ ms: %u %u %u %u %u\n", stats.age_bins[0], stats.age_bins[1],
+           stats.age_bins[2], stats.age_bins[3], stats.age_bins[4]);
+    CHECK(stats.sent == (uint16_t)periods);
+    CHECK(stats.over_budget == 0);
+    CHECK(stats.age_max_us <= PERIOD_US + 1500 + 270 + 1);
+    return 0;
+}
+
+int main(void) {
+    int failed = test_idle_bus()
+        | test_enable_frame_never_late()
+        | test_frame_on_wire_finishes()
+        | test_stale_data_zero_torque()
+        | test_over_budget()
+        | bench_latency();
+    return failed;
+}
@@ -0,0 +1,125 @@
+#include "tick.h"
+#include "log.h"
+
+tick_stats_t tick_stats;
+
+static volatile uint32_t tick_ms = 0;
+static volatile uint8_t pending_ticks = 0;
+static uint32_t idle_counts = 0;
+
+static void tick_isr(void) {
+    tick_ms += TICK_PERIOD_MS;
+    
+    // Saturate instead of wrapping so a long stall still reads as an overrun
+    if (pending_ticks < 0xFF) {
+        pending_ticks++;
+    }
+}
+
+void tick_init(void) {
+    tick_reset_stats();
+    TMR0_SetInterruptHandler(tick_isr);
+}
+
+uint8_t tick_wait(void) {
+    INTERRUPT_GlobalInterruptDisable();
+    uint16_t wait_start = TMR1_ReadTimer();
+    uint16_t isr_start = INTERRUPT_GetBusyCounts();
+    INTERRUPT_GlobalInterruptEnable();
+    
+    while (pending_ticks == 0) {
+        // nothing to do until the next tick
+    }
+    
+    // Time since the tick fired, read before anything else can delay it
+    uint8_t latency = TMR0_ReadTimer();
+    
+    INTERRUPT_GlobalInterruptDisable();
+    uint8_t missed = pending_ticks - 1;
+    pending_ticks = 0;
+    // The wait is at most one tick, well inside TMR1's 131 ms wrap
+    uint16_t waited = TMR1_ReadTimer() - wait_start;
+    uint16_t isr = INTERRUPT_GetBusyCounts() - isr_start;
+    INTERRUPT_GlobalInterruptEnable();
+    
+    if (waited > isr) {
+        idle_counts += waited - isr;
+    }
+    
+    if (missed) {
+        // TMR0 has wrapped since the tick we are late for, so the latency
+        // reading is meaningless
+        tick_stats.overruns += missed;
+    } else {
+        if (latency < tick_stats.latency_min) {
+            tick_stats.latency_min = latency;
+        }
+        if (latency > tick_stats.latency_max) {
+            tick_stats.latency_max = latency;
+        }
+    }
+    
+    return missed;
+}
+
+uint32_t tick_take_idle_us(void) {
+    uint32_t idle_us = idle_counts * TICK_IDLE_US_PER_COUNT;
+    
+    idle_counts = 0;
+    return idle_us;
+}
+
+uint32_t tick_get_ms(void) {
+    // 32-bit reads are not atomic on the PIC18
+    INTERRUPT_GlobalInterruptDisable();
+    uint32_t ms = tick_ms;
+    INTERRUPT_GlobalInterruptEnable();
+    
+    return ms;
+}
+
+uint32_t tick_get_ms_isr(void) {
+    return tick_ms;
+}
+
+uint32_t tick_get_us_isr(void) {
+    uint8_t counts = TMR0_ReadTimer();
+    uint32_t ms = tick_ms;
+    if (PIR3bits.TMR0IF) {
+        // TMR0 rolled over but the ISR has not counted it yet
+        counts = TMR0_ReadTimer();
+        ms += TICK_PERIOD_MS;
+    }
+    
+    return ms * 1000 + TICK_COUNTS_TO_US(counts);
+}
+
+uint32_t tick_get_us(void) {
+    INTERRUPT_GlobalInterruptDisable();
+    uint32_t us = tick_get_us_isr();
+    INTERRUPT_GlobalInterruptEnable();
+    
+    return us;
+}
+
+void tick_delay_ms(uint16_t ms) {
+    uint32_t start = tick_get_ms();
+    
+    while (tick_get_ms() - start < ms) {
+        // wait
+    }
+}
+
+void tick_reset_stats(void) {
+    tick_stats.latency_min = 0xFFFF;
+    tick_stats.latency_max = 0;
+    tick_stats.overruns = 0;
+}
+
+void tick_print_stats(void) {
+    // jitter is the spread between the earliest and latest wake-up
+    LOG_INFO(TICK_STATS,
+            TICK_COUNTS_TO_US(tick_stats.latency_min),
+            TICK_COUNTS_TO_US(tick_stats.latency_max),
+            tick_stats.overruns);
+}
@@ -0,0 +1,58 @@
+#ifndef TICK_H
+#define TICK_H
+
+#include "mcc_generated_files/mcc.h"
+
+// Fixed-rate control tick
+// TMR0 interrupts every TICK_PERIOD_MS and main() runs exactly one FSM step
+// per tick, so the control period no longer depends on how long the previous
+// step took to run
+
+#define TICK_PERIOD_MS 1
+
+// TMR0 counts the 500 kHz MFINTOSC through a 1:2 prescaler, so the tick
+// does not change when the core clock profile does
+#define TICK_US_PER_COUNT 4
+#define TICK_COUNTS_TO_US(counts) ((uint32_t)(counts) * TICK_US_PER_COUNT)
+
+// Idle time is timed on the free-running TMR1, 500 kHz MFINTOSC
+#define TICK_IDLE_US_PER_COUNT 2
+
+typedef struct {
+    uint16_t latency_min;   // TMR0 counts between the tick and tick_wait() returning
+    uint16_t latency_max;
+    uint16_t overruns;      // ticks that fired while the previous step was still running
+} tick_stats_t;
+
+extern tick_stats_t tick_stats;
+
+void tick_init(void);
+
+// Blocks until the next tick and returns how many ticks were missed since
+// the last call (0 when the previous step fit inside its period)
+uint8_t tick_wait(void);
+
+// Time spent waiting in tick_wait() since the last call, less the
+// interrupts taken meanwhile; everything else is CPU load
+uint32_t tick_take_idle_us(void);
+
+// Milliseconds since tick_init(), wraps after ~49 days
+uint32_t tick_get_ms(void);
+
+// Same as tick_get_ms() but for use inside an ISR, where interrupts are already off
+uint32_t tick_get_ms_isr(void);
+
+// Microseconds since tick_init(), resolved to one TMR0 count; wraps after ~71 minutes
+uint32_t tick_get_us(void);
+
+// Same as tick_get_us() but for use inside an ISR, where interrupts are already off
+uint32_t tick_get_us_isr(void);
+
+// Busy-waits on the tick, so it stays correct at any core clock
+// (__delay_ms() is fixed to _XTAL_FREQ at compile time)
+void tick_delay_ms(uint16_t ms);
+
+void tick_reset_stats(void);
+void tick_print_stats(void);
+
+#endif // TICK_H
@@ -0,0 +1,311 @@
+#!/usr/bin/env python3
+"""Generate C pack/unpack functions for the CAN messages in a DBC file.
+
+Every message gets a struct of its raw signal values and a static inline
+pack and unpack function that fill or read a uCAN_MSG (see ecan.h). The
+bit layout is resolved here, so each function is a fixed list of shifts
+and masks on the data bytes; nothing is looked up or looped over at run
+time, and XC8 inlines them like hand-written code.
+
+    python3 tools/dbc_codegen.py can.dbc can_messages.h
+
+The MPLAB project runs this as its pre-build step, so edit can.dbc and
+never the header. The header is only rewritten when it would change.
+
+Signals are raw integers, as on the wire; the factor, offset and unit from
+the DBC go into a comment on each field. Both byte orders (@1 Intel, @0
+Motorola) are supported, signals up to 32 bits. Multiplexed messages and
+floats are not, and are refused, as are overlapping signals and signals
+that do not fit the message's DLC.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+MESSAGE = re.compile(r"^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+)")
+SIGNAL = re.compile(r"^SG_\s+(\w+)\s*(\S*)\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*"
+                    r"\(([^,]+),([^)]+)\)\s*\[([^|]*)\|([^\]]*)\]\s*\"([^\"]*)\"")
+COMMENT = re.compile(r'^CM_\s+(BO_|SG_)\s+(\d+)\s+(?:(\w+)\s+)?"([^"]*)"\s*;', re.M)
+
+EXTENDED_FLAG = 0x80000000
+
+
+class DbcError(Exception):
+    pass
+
+
+class Signal:
+    def __init__(self, name, start, length, intel, signed, factor, offset, unit):
+        self.name = name
+        self.start = start
+        self.length = length
+        self.intel = intel
+        self.signed = signed
+        self.factor = factor
+        self.offset = offset
+        self.unit = unit
+        self.comment = ""
+
+    @property
+    def width(self):
+        return 8 if self.length <= 8 else 16 if self.length <= 16 else 32
+
+    @property
+    def ctype(self):
+        return "%sint%u_t" % ("" if self.signed else "u", self.width)
+
+    def positions(self):
+        """Message bit (byte * 8 + bit in byte) of each value bit, LSB first."""
+        if self.intel:
+            return [self.start + i for i in range(self.length)]
+        # Motorola: the start bit is the MSB, and the bits run down each
+        # byte and on to the top of the next one
+        positions = []
+        position = self.start
+        for _ in range(self.length):
+            positions.append(position)
+            position = position + 15 if position % 8 == 0 else position - 1
+        return positions[::-1]
+
+    def chunks(self):
+        """(byte, bit in byte, value bit, bit count) per data byte touched."""
+        chunks = []
+        for value_bit, position in enumerate(self.positions()):
+            byte, bit = divmod(position, 8)
+            last = chunks[-1] if chunks else None
+            if last and last[0] == byte and last[1] + last[3] == bit:
+                chunks[-1] = (byte, last[1], last[2], last[3] + 1)
+            else:
+                chunks.append((byte, bit, value_bit, 1))
+        return chunks
+
+
+class Message:
+    def __init__(self, can_id, name, dlc, sender):
+        self.extended = bool(can_id & EXTENDED_FLAG)
+        self.can_id = can_id & ~EXTENDED_FLAG
+        self.name = name
+        self.dlc = dlc
+        self.sender = sender
+        self.signals = []
+        self.comment = ""
+
+
+def number(text):
+    value = float(text)
+    return int(value) if value.is_integer() else value
+
+
+def parse(path):
+    messages = []
+    by_id = {}
+    with open(path) as f:
+        text = f.read()
+
+    for line_number, line in enumerate(text.splitlines(), 1):
+        line = line.strip()
+        where = "%s:%u" % (path, line_number)
+        if line.startswith("BO_ "):
+            match = MESSAGE.match(line)
+            if not match:
+                raise DbcError("%s: bad message" % where)
+            can_id, name, dlc, sender = match.groups()
+            message = Message(int(can_id), name, int(dlc), sender)
+            if message.dlc > 8:
+                raise DbcError("%s: %s has a DLC over 8" % (where, name))
+            messages.append(message)
+            by_id[int(can_id)] = message
+        elif line.startswith("SG_ "):
+            match = SIGNAL.match(line)
+            if not match or not messages:
+                raise DbcError("%s: bad signal" % where)
+            name, mux, start, length, order, sign, factor, offset, _, _, unit = match.groups()
+            if mux:
+                raise DbcError("%s: multiplexed signal %s is not supported" % (where, name))
+            signal = Signal(name, int(start), int(length), order == "1", sign == "-",
+                            number(factor), number(offset), unit)
+            if not 1 <= signal.length <= 32:
+                raise DbcError("%s: %s must be 1 to 32 bits" % (where, name))
+            messages[-1].signals.append(signal)
+        elif line.startswith("SIG_VALTYPE_ "):
+            raise DbcError("%s: float signals are not supported" % where)
+
+    for kind, can_id, signal_name, comment in COMMENT.findall(text):
+        message = by_id.get(int(can_id))
+        if message is None:
+            continue
+        if kind == "BO_":
+            message.comment = comment
+        else:
+            for signal in message.signals:
+                if signal.name == signal_name:
+                    signal.comment = comment
+
+    for message in messages:
+        check_layout(message)
+    return messages
+
+
+def check_layout(message):
+    used = {}
+    for signal in message.signals:
+        for position in signal.positions():
+            if not 0 <= position < message.dlc * 8:
+                raise DbcError("%s.%s does not fit in %u bytes" % (message.name, signal.name, message.dlc))
+            if position in used:
+                raise DbcError("%s.%s overlaps %s" % (message.name, signal.name, used[position]))
+            used[position] = signal.name
+
+
+def c_name(name):
+    return re.sub(r"(?<=[a-z0-9])(?=[A-Z])", "_", name).lower()
+
+
+def mask(bits):
+    return "0x%X" % ((1 << bits) - 1)
+
+
+def field_comment(signal):
+    parts = []
+    if signal.comment:
+        parts.append(signal.comment.rstrip("."))
+    scale = []
+    if signal.factor != 1:
+        scale.append("%g" % signal.factor)
+    if signal.unit:
+        scale.append(signal.unit)
+    if scale:
+        parts.append(" ".join(scale))
+    if signal.offset != 0:
+        parts.append("offset %g" % signal.offset)
+    return ", ".join(parts)
+
+
+def pack_terms(signal, field):
+    utype = "uint%u_t" % signal.width
+    terms = {}
+    for byte, bit, value_bit, count in signal.chunks():
+        term = "(%s)%s" % (utype, field)
+        shifted = False
+        if value_bit:
+            term = "(%s >> %u)" % (term, value_bit)
+            shifted = True
+        # Bits above the chunk only need masking if they would land in
+        # this byte rather than fall off its top
+        if bit + count < 8 and value_bit + count < signal.width:
+            term = "(%s & %s)" % (term, mask(count))
+            shifted = True
+        if bit:
+            term = "(%s << %u)" % (term, bit)
+            shifted = True
+        terms.setdefault(byte, []).append("(uint8_t)%s" % (term if shifted else field))
+    return terms
+
+
+def unpack_expression(signal):
+    utype = "uint%u_t" % signal.width
+    terms = []
+    for byte, bit, value_bit, count in signal.chunks():
+        term = "msg->frame.data%u" % byte
+        if bit:
+            term = "(%s >> %u)" % (term, bit)
+        if bit + count < 8:
+            term = "(%s & %s)" % (term, mask(count))
+        term = "(%s)%s" % (utype, term)
+        if value_bit:
+            term = "(%s << %u)" % (term, value_bit)
+        terms.append(term)
+    raw = " | ".join(terms)
+    if not signal.signed:
+        return "(%s)(%s)" % (signal.ctype, raw) if len(terms) > 1 else raw
+    if signal.length == signal.width:
+        return "(%s)(%s)" % (signal.ctype, raw)
+    # Sign-extend from the top bit of the signal
+    sign = "0x%X" % (1 << (signal.length - 1))
+    return "(%s)((%s)((%s) ^ %s) - %s)" % (signal.ctype, utype, raw, sign, sign)
+
+
+def generate(messages, source):
+    lines = [
+        "#ifndef CAN_MESSAGES_H",
+        "#define CAN_MESSAGES_H",
+        "",
+        '#include "mcc_generated_files/ecan.h"',
+        "",
+        "// Generated by tools/dbc_codegen.py from %s; edit that instead" % source,
+        "// Signals are raw values as on the wire, scaled as commented",
+    ]
+
+    for message in messages:
+        name = c_name(message.name)
+        define = name.upper()
+        signals = [(signal, c_name(signal.name)) for signal in message.signals]
+        id_type = "dEXTENDED_CAN_MSG_ID_2_0B" if message.extended else "dSTANDARD_CAN_MSG_ID_2_0B"
+
+        lines += ["", "", "// %s, sent by %s" % (message.name, message.sender)]
+        if message.comment:
+            lines.append("// %s" % message.comment)
+        lines += [
+            "#define CAN_ID_%s 0x%03X" % (define, message.can_id),
+            "#define CAN_DLC_%s %u" % (define, message.dlc),
+            "",
+            "typedef struct {",
+        ]
+        declarations = ["    %s %s;" % (signal.ctype, field) for signal, field in signals]
+        column = max((len(d) for d in declarations), default=0) + 2
+        for declaration, (signal, _) in zip(declarations, signals):
+            comment = field_comment(signal)
+            lines.append(declaration.ljust(column) + "// " + comment if comment else declaration)
+        if not signals:
+            lines.append("    uint8_t unused;")
+        lines += ["} %s_t;" % name, ""]
+
+        lines += [
+            "static inline void %s_pack(uCAN_MSG* msg, const %s_t* signals) {" % (name, name),
+            "    msg->frame.idType = %s;" % id_type,
+            "    msg->frame.id = CAN_ID_%s;" % define,
+            "    msg->frame.dlc = CAN_DLC_%s;" % define,
+        ]
+        terms = {}
+        for signal, field in signals:
+            for byte, byte_terms in pack_terms(signal, "signals->" + field).items():
+                terms.setdefault(byte, []).extend(byte_terms)
+        for byte in range(8):
+            lines.append("    msg->frame.data%u = %s;" % (byte, " | ".join(terms.get(byte, ["0"]))))
+        lines += ["}", ""]
+
+        lines.append("static inline void %s_unpack(const uCAN_MSG* msg, %s_t* signals) {" % (name, name))
+        for signal, field in signals:
+            lines.append("    signals->%s = %s;" % (field, unpack_expression(signal)))
+        lines.append("}")
+
+    lines += ["", "#endif // CAN_MESSAGES_H", ""]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("dbc")
+    parser.add_argument("header")
+    args = parser.parse_args()
+
+    try:
+        messages = parse(args.dbc)
+    except DbcError as e:
+        sys.exit("dbc_codegen: %s" % e)
+    header = generate(messages, os.path.basename(args.dbc))
+
+    # Leave the file alone when nothing changed, so make does not rebuild
+    # everything that includes it
+    if os.path.exists(args.header):
+        with open(args.header, newline="") as f:
+            if f.read() == header:
+                return
+    with open(args.header, "w", newline="") as f:
+        f.write(header)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+"""Decode the binary telemetry stream from the VCU's UART1.
+
+Frames are COBS-encoded between 0x00 delimiters and end with a
+little-endian CRC-16-CCITT (poly 0x1021, seed 0xFFFF), matching telemetry.c.
+Anything between delimiters that is not a valid frame is printed as text.
+
+Log frames carry only a token and varint arguments; the formats, and the
+names for enum arguments, come from the dictionary in log_messages.def.
+
+When reading a serial port, lines typed on stdin are sent to the console
+(see console.h), e.g. "set discrepancy_percent 8".
+
+    python3 tools/telemetry_decode.py /dev/ttyUSB0          # needs pyserial
+    python3 tools/telemetry_decode.py - < capture.bin
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import threading
+
+BAUD = 9600
+DICTIONARY = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "log_messages.def")
+
+# Mirrors telemetry.h
+FRAME_SAMPLES = 1
+FRAME_TRANSITION = 2
+FRAME_LOG = 3
+FRAME_TRACE = 4
+TELEMETRY_BATCH = 16
+HEADER = struct.Struct("<BBH")
+SAMPLES = struct.Struct("<BBH" + "HHH" * TELEMETRY_BATCH)
+TRANSITION = struct.Struct("<BBBB")
+# Mirrors trace.h
+TRACE = struct.Struct("<BBIBBBBHHH")
+
+
+# Mirrors log.h
+LEVEL_NAMES = ["DEBUG", "INFO", "WARN", "ERROR"]
+SPECIFIER = re.compile(r"%(?:\{(\w+)\}|(l?)([udx]))")
+
+
+class Dictionary:
+    """Messages (in token order) and tables from log_messages.def."""
+
+    def __init__(self, path):
+        self.messages = []
+        self.tables = {}
+        with open(path) as f:
+            for line in f:
+                line = line.strip()
+                if line.startswith("LOG_MESSAGE("):
+                    name, fmt = re.match(r'LOG_MESSAGE\((\w+),\s*"(.*)"\)', line).groups()
+                    self.messages.append((name, fmt))
+                elif line.startswith("LOG_TABLE("):
+                    name, entries = re.match(r"LOG_TABLE\((\w+),(.*)\)", line).groups()
+                    self.tables[name] = re.findall(r'"([^"]*)"', entries)
+
+    def name(self, table, index):
+        entries = self.tables.get(table, [])
+        return entries[index] if index < len(entries) else "%s[%u]" % (table, index)
+
+    def format(self, token, args):
+        if token >= len(self.messages):
+            return "unknown log token %u %s" % (token, args)
+        fmt = self.messages[token][1]
+        args = iter(args)
+
+        def substitute(match):
+            table, long, conversion = match.groups()
+            value = next(args, 0)
+            if table:
+                return self.name(table, value)
+            bits = 32 if long else 16
+            value &= (1 << bits) - 1
+            if conversion == "d" and value >= 1 << (bits - 1):
+                value -= 1 << bits
+            return ("%x" if conversion == "x" else "%d") % value
+
+        return SPECIFIER.sub(substitute, fmt)
+
+
+def varints(data):
+    values, value, shift = [], 0, 0
+    for byte in data:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            values.append(value)
+            value, shift = 0, 0
+    return values
+
+
+def _crc16_table():
+    table = []
+    for byte in range(256):
+        crc = byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+        table.append(crc)
+    return table
+
+
+CRC16_TABLE = _crc16_table()
+
+
+def crc16(data, crc=0xFFFF):
+    # Table driven so a recording keeps up with the link at full rate
+    for byte in data:
+        crc = ((crc << 8) & 0xFFFF) ^ CRC16_TABLE[(crc >> 8) ^ byte]
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        block = data[i + 1:i + code]
+        if code == 0 or len(block) != code - 1:
+            return None
+        out += block
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_frame(chunk):
+    """Returns (type, sequence, time_ms, payload) for a frame, or None if chunk is not one."""
+    raw = cobs_decode(chunk)
+    if raw is None or len(raw) < HEADER.size + 2:
+        return None
+    body, crc = raw[:-2], struct.unpack("<H", raw[-2:])[0]
+    if crc16(body) != crc:
+        return None
+
+    frame_type, sequence, time_ms = HEADER.unpack_from(body)
+    return frame_type, sequence, time_ms, body[HEADER.size:]
+
+
+def decode_frame(chunk, dictionary):
+    """Returns (sequence, text) for a frame, or None if chunk is not one."""
+    frame = parse_frame(chunk)
+    if frame is None:
+        return None
+
+    frame_type, sequence, time_ms, payload = frame
+    if frame_type == FRAME_SAMPLES and len(payload) == SAMPLES.size:
+        fields = SAMPLES.unpack(payload)
+        state, error, torque = fields[:3]
+        lines = ["[%3u] %5u ms %s %s torque %u" % (
+            sequence, time_ms, dictionary.name("state", state), dictionary.name("error", error), torque)]
+        for i in range(TELEMETRY_BATCH):
+            throttle1, throttle2, brake = fields[3 + 3 * i:6 + 3 * i]
+            lines.append("      throttle1 %5u throttle2 %5u brake %5u" % (throttle1, throttle2, brake))
+        return sequence, "\n".join(lines)
+    if frame_type == FRAME_TRANSITION and len(payload) == TRANSITION.size:
+        from_state, from_error, to_state, to_error = TRANSITION.unpack(payload)
+        text = "[%3u] %5u ms %s -> %s" % (
+            sequence, time_ms, dictionary.name("state", from_state), dictionary.name("state", to_state))
+        if to_error:
+            text += " Error: %s" % dictionary.name("error", to_error)
+        return sequence, text
+    if frame_type == FRAME_TRACE and len(payload) == TRACE.size:
+        (index, count, entry_ms, from_state, from_error, to_state, to_error,
+         throttle1, throttle2, brake) = TRACE.unpack(payload)
+        text = "[%3u] trace %2u/%u at %lu ms %s -> %s" % (
+            sequence, index + 1, count, entry_ms,
+            dictionary.name("state", from_state), dictionary.name("state", to_state))
+        if to_error:
+            text += " Error: %s" % dictionary.name("error", to_error)
+        text += "\n      throttle1 %5u throttle2 %5u brake %5u" % (throttle1, throttle2, brake)
+        return sequence, text
+    if frame_type == FRAME_LOG and len(payload) >= 2:
+        level, token = payload[0], payload[1]
+        level_name = LEVEL_NAMES[level] if level < len(LEVEL_NAMES) else str(level)
+        return sequence, "[%3u] %5u ms %-5s %s" % (
+            sequence, time_ms, level_name, dictionary.format(token, varints(payload[2:])))
+    return None
+
+
+class Decoder:
+    def __init__(self, out, dictionary):
+        self.out = out
+        self.dictionary = dictionary
+        self.chunk = bytearray()
+        self.sequence = None
+        self.lost = 0
+
+    def feed(self, data):
+        for byte in data:
+            if byte != 0:
+                self.chunk.append(byte)
+                continue
+            self.flush()
+
+    def flush(self):
+        if not self.chunk:
+            return
+        frame = decode_frame(bytes(self.chunk), self.dictionary)
+        if frame is None:
+            # Not a frame: housekeeping text, or a frame hit by line noise
+            text = self.chunk.decode("ascii", "replace").rstrip()
+        else:
+            sequence, text = frame
+            if self.sequence is not None and sequence != (self.sequence + 1) & 0xFF:
+                self.lost += (sequence - self.sequence - 1) & 0xFF
+                text += "  (%u frames lost so far)" % self.lost
+            self.sequence = sequence
+        self.chunk.clear()
+        if text:
+            print(text, file=self.out, flush=True)
+
+
+def forward_commands(port):
+    for line in sys.stdin:
+        port.write(line.strip().encode("ascii", "replace") + b"\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="serial port, or - for stdin")
+    parser.add_argument("--baud", type=int, default=BAUD)
+    parser.add_argument("--dictionary", default=DICTIONARY, help="log_messages.def the firmware was built with")
+    args = parser.parse_args()
+
+    decoder = Decoder(sys.stdout, Dictionary(args.dictionary))
+    if args.source == "-":
+        stream = sys.stdin.buffer
+        read = lambda: stream.read(256)
+    else:
+        import serial
+        port = serial.Serial(args.source, args.baud, timeout=0.1)
+        read = lambda: port.read(256)
+        threading.Thread(target=forward_commands, args=(port,), daemon=True).start()
+
+    try:
+        while True:
+            data = read()
+            if args.source == "-" and not data:
+                break
+            decoder.feed(data)
+    except KeyboardInterrupt:
+        pass
+    decoder.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,322 @@
+#!/usr/bin/env python3
+"""Record the VCU's telemetry stream to a compressed columnar file.
+
+Reads frames from a serial port or pty (or stdin) like telemetry_decode.py,
+and stores them as one column per signal instead of text, so runs of
+several hours stay small and quick to load:
+
+    python3 tools/telemetry_record.py record /dev/ttyUSB0 run.vcr   # needs pyserial
+    python3 tools/telemetry_record.py record - run.vcr < capture.bin
+    python3 tools/telemetry_record.py info run.vcr
+    python3 tools/telemetry_record.py export run.vcr samples > samples.csv
+
+File layout, all little-endian:
+
+    magic       b"VCUREC1\\n"
+    block*      one table's next rows:
+        u8 name length, name
+        u32 row count, u8 column count
+        column* u8 name length, name, u8 kind, u32 data length, zlib data
+
+A kind of "d" is an integer column stored as int32 deltas from the previous
+row of the block (times and slowly moving signals compress to almost
+nothing); "t" is UTF-8 text, one row per line. Blocks are written every
+BLOCK_ROWS rows or BLOCK_SECONDS, so a crash loses at most a few seconds.
+
+Device time_ms is 16 bits on the wire; it is unwrapped here into a
+32-bit ms count, taking each step from the previous frame as the nearest
+one (within +-32 s), since frames are not sent in time order.
+"""
+
+import argparse
+import array
+import csv
+import queue
+import struct
+import sys
+import threading
+import time
+import zlib
+
+import telemetry_decode as telemetry
+
+MAGIC = b"VCUREC1\n"
+BLOCK_ROWS = 4096
+BLOCK_SECONDS = 5.0
+
+# Matches the telemetry task period in main.c
+SAMPLE_PERIOD_MS = 9
+
+# Columns per table; "d" is an integer column, "t" is text
+TABLES = {
+    "samples": [("time_ms", "d"), ("state", "d"), ("error", "d"), ("torque", "d"),
+                ("throttle1", "d"), ("throttle2", "d"), ("brake", "d")],
+    "transitions": [("time_ms", "d"), ("from_state", "d"), ("from_error", "d"),
+                    ("to_state", "d"), ("to_error", "d")],
+    "logs": [("time_ms", "d"), ("level", "d"), ("text", "t")],
+    "trace": [("entry_ms", "d"), ("from_state", "d"), ("from_error", "d"), ("to_state", "d"),
+              ("to_error", "d"), ("throttle1", "d"), ("throttle2", "d"), ("brake", "d")],
+    # Anything between delimiters that was not a valid frame
+    "text": [("time_ms", "d"), ("text", "t")],
+}
+
+
+def pack_name(name):
+    data = name.encode("ascii")
+    return struct.pack("<B", len(data)) + data
+
+
+def encode_column(kind, values):
+    if kind == "t":
+        return zlib.compress("\n".join(values).encode("utf-8"))
+    deltas = array.array("i")
+    previous = 0
+    for value in values:
+        deltas.append(value - previous)
+        previous = value
+    if sys.byteorder != "little":
+        deltas.byteswap()
+    return zlib.compress(deltas.tobytes())
+
+
+def decode_column(kind, data, rows):
+    data = zlib.decompress(data)
+    if kind == "t":
+        return data.decode("utf-8").split("\n") if rows else []
+    deltas = array.array("i")
+    deltas.frombytes(data)
+    if sys.byteorder != "little":
+        deltas.byteswap()
+    values, value = [], 0
+    for delta in deltas:
+        value += delta
+        values.append(value)
+    return values
+
+
+class Writer:
+    """Buffers rows per table and writes them as compressed column blocks."""
+
+    def __init__(self, out):
+        self.out = out
+        self.out.write(MAGIC)
+        self.rows = {name: [] for name in TABLES}
+        self.flushed = time.monotonic()
+
+    def add(self, table, row):
+        rows = self.rows[table]
+        rows.append(row)
+        if len(rows) >= BLOCK_ROWS:
+            self.write_block(table)
+
+    def poll(self):
+        if time.monotonic() - self.flushed >= BLOCK_SECONDS:
+            self.flush()
+
+    def flush(self):
+        for table in TABLES:
+            self.write_block(table)
+        self.out.flush()
+        self.flushed = time.monotonic()
+
+    def write_block(self, table):
+        rows = self.rows[table]
+        if not rows:
+            return
+        columns = TABLES[table]
+        block = [pack_name(table), struct.pack("<IB", len(rows), len(columns))]
+        for index, (name, kind) in enumerate(columns):
+            data = encode_column(kind, [row[index] for row in rows])
+            block += [pack_name(name), kind.encode("ascii"), struct.pack("<I", len(data)), data]
+        self.out.write(b"".join(block))
+        rows.clear()
+
+
+def read_blocks(path):
+    """Yields (table, {column: values}) for every block in a recording."""
+    with open(path, "rb") as f:
+        if f.read(len(MAGIC)) != MAGIC:
+            raise ValueError("%s is not a VCU recording" % path)
+
+        def read_name():
+            length = f.read(1)
+            return f.read(length[0]).decode("ascii") if length else None
+
+        while True:
+            table = read_name()
+            if table is None:
+                return
+            rows, count = struct.unpack("<IB", f.read(5))
+            columns = {}
+            for _ in range(count):
+                name = read_name()
+                kind = f.read(1).decode("ascii")
+                length, = struct.unpack("<I", f.read(4))
+                columns[name] = decode_column(kind, f.read(length), rows)
+            yield table, columns
+
+
+class Recorder:
+    """Splits the stream into frames and turns them into table rows."""
+
+    def __init__(self, writer, dictionary):
+        self.writer = writer
+        self.dictionary = dictionary
+        self.chunk = bytearray()
+        self.time_ms = None
+        self.sequence = None
+        self.frames = 0
+        self.lost = 0
+        self.bad = 0
+
+    def feed(self, data):
+        # Split on the delimiters in bulk; the bytes after the last one
+        # are the start of the next frame
+        parts = (bytes(self.chunk) + data).split(b"\x00")
+        self.chunk = bytearray(parts.pop())
+        for part in parts:
+            if part:
+                self.record(part)
+
+    def unwrap(self, time_ms):
+        if self.time_ms is None:
+            self.time_ms = time_ms
+        else:
+            # Frames do not arrive in time order: a sample frame is stamped
+            # with its first sample but sent after the whole batch, behind
+            # any transition and log frames, so a step can be backwards
+            delta = (time_ms - self.time_ms) & 0xFFFF
+            if delta >= 0x8000:
+                delta -= 0x10000
+            self.time_ms += delta
+        return self.time_ms
+
+    def record(self, chunk):
+        frame = telemetry.parse_frame(chunk)
+        if frame is None:
+            self.bad += 1
+            text = chunk.decode("ascii", "replace").rstrip()
+            self.writer.add("text", (self.time_ms or 0, text))
+            return
+
+        frame_type, sequence, time_ms, payload = frame
+        self.frames += 1
+        if self.sequence is not None:
+            self.lost += (sequence - self.sequence - 1) & 0xFF
+        self.sequence = sequence
+        time_ms = self.unwrap(time_ms)
+
+        if frame_type == telemetry.FRAME_SAMPLES and len(payload) == telemetry.SAMPLES.size:
+            fields = telemetry.SAMPLES.unpack(payload)
+            state, error, torque = fields[:3]
+            for i in range(telemetry.TELEMETRY_BATCH):
+                throttle1, throttle2, brake = fields[3 + 3 * i:6 + 3 * i]
+                self.writer.add("samples", (time_ms + i * SAMPLE_PERIOD_MS, state, error, torque,
+                                            throttle1, throttle2, brake))
+        elif frame_type == telemetry.FRAME_TRANSITION and len(payload) == telemetry.TRANSITION.size:
+            self.writer.add("transitions", (time_ms,) + telemetry.TRANSITION.unpack(payload))
+        elif frame_type == telemetry.FRAME_LOG and len(payload) >= 2:
+            level, token = payload[0], payload[1]
+            text = self.dictionary.format(token, telemetry.varints(payload[2:]))
+            self.writer.add("logs", (time_ms, level, text))
+        elif frame_type == telemetry.FRAME_TRACE and len(payload) == telemetry.TRACE.size:
+            # Index and count only matter while the dump is in flight
+            self.writer.add("trace", telemetry.TRACE.unpack(payload)[2:])
+
+
+def record(args):
+    if args.source == "-":
+        stream = sys.stdin.buffer
+        read = lambda: stream.read1(65536)
+    else:
+        import serial
+        # Works for ptys too; the baud rate is then ignored
+        port = serial.Serial(args.source, args.baud, timeout=0.1)
+        read = lambda: port.read(max(1, port.in_waiting))
+
+    # A thread does nothing but read, so compressing a block never leaves
+    # the tty's small kernel buffer to overflow
+    chunks = queue.Queue()
+
+    def reader():
+        try:
+            while True:
+                data = read()
+                if args.source == "-" and not data:
+                    break
+                if data:
+                    chunks.put(data)
+        finally:
+            chunks.put(None)
+
+    threading.Thread(target=reader, daemon=True).start()
+
+    with open(args.output, "wb") as out:
+        writer = Writer(out)
+        recorder = Recorder(writer, telemetry.Dictionary(args.dictionary))
+        last_status = time.monotonic()
+        try:
+            while True:
+                try:
+                    data = chunks.get(timeout=0.5)
+                except queue.Empty:
+                    data = b""
+                if data is None:
+                    break
+                recorder.feed(data)
+                writer.poll()
+                if not args.quiet and time.monotonic() - last_status >= 10:
+                    last_status = time.monotonic()
+                    print("%u frames, %u lost, %u bad" % (recorder.frames, recorder.lost, recorder.bad),
+                          file=sys.stderr)
+        except KeyboardInterrupt:
+            pass
+        writer.flush()
+    print("%u frames, %u lost, %u bad" % (recorder.frames, recorder.lost, recorder.bad), file=sys.stderr)
+
+
+def info(args):
+    rows = {}
+    for table, columns in read_blocks(args.recording):
+        rows[table] = rows.get(table, 0) + len(next(iter(columns.values())))
+    for table in TABLES:
+        print("%-12s %9u rows" % (table, rows.get(table, 0)))
+
+
+def export(args):
+    out = csv.writer(sys.stdout)
+    names = [name for name, _ in TABLES[args.table]]
+    out.writerow(names)
+    for table, columns in read_blocks(args.recording):
+        if table == args.table:
+            out.writerows(zip(*(columns[name] for name in names)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    parser_record = commands.add_parser("record", help="record a stream until it ends or Ctrl-C")
+    parser_record.add_argument("source", help="serial port or pty, or - for stdin")
+    parser_record.add_argument("output")
+    parser_record.add_argument("--baud", type=int, default=telemetry.BAUD)
+    parser_record.add_argument("--dictionary", default=telemetry.DICTIONARY,
+                               help="log_messages.def the firmware was built with")
+    parser_record.add_argument("--quiet", action="store_true", help="no progress every 10 s")
+    parser_record.set_defaults(run=record)
+
+    parser_info = commands.add_parser("info", help="rows per table")
+    parser_info.add_argument("recording")
+    parser_info.set_defaults(run=info)
+
+    parser_export = commands.add_parser("export", help="one table as CSV")
+    parser_export.add_argument("recording")
+    parser_export.add_argument("table", choices=list(TABLES))
+    parser_export.set_defaults(run=export)
+
+    args = parser.parse_args()
+    args.run(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,88 @@
+#include "torque_cmd.h"
+#include "torque_map.h"
+#include "tick.h"
+
+#include <string.h>
+
+// TXB0 is not fed by can_tx, see CAN_TX_FIRST_BUFFER
+#define TORQUE_CMD_BUFFER 0
+#define TORQUE_CMD_PRIORITY 3
+
+static volatile torque_cmd_stats_t stats;
+
+// Sample time of the frame in TXB0
+static uint32_t frame_sample_us;
+
+static void tx_done_isr(uint8_t buffer) {
+    uint32_t age_us = tick_get_us_isr() - frame_sample_us;
+    
+    stats.sent++;
+    if (age_us > stats.age_max_us) {
+        stats.age_max_us = age_us;
+    }
+    if (age_us > TORQUE_CMD_BUDGET_US) {
+        stats.over_budget++;
+    }
+    
+    // Compares instead of dividing, which is slow on 32 bits
+    uint8_t bin = 0;
+    while (bin < TORQUE_CMD_AGE_BINS - 1 && age_us >= (bin + 1) * (uint32_t)TORQUE_CMD_AGE_BIN_US) {
+        bin++;
+    }
+    stats.age_bins[bin]++;
+}
+
+static void mask_tx_interrupt(bool masked) {
+    PIE5bits.TXB0IE = !masked;
+}
+
+void torque_cmd_init(void) {
+    memset((void*)&stats, 0, sizeof(stats));
+    ECAN_SetTXBnPriority(TORQUE_CMD_BUFFER, TORQUE_CMD_PRIORITY);
+    ECAN_SetTXBnInterruptHandler(TORQUE_CMD_BUFFER, tx_done_isr);
+}
+
+void torque_cmd_send(uint16_t torque, bool enabled, uint32_t sample_us) {
+    inverter_command_t command;
+    uCAN_MSG msg;
+    
+    // A stalled scan must not keep the last torque applied
+    if (tick_get_us() - sample_us > TORQUE_CMD_BUDGET_US) {
+        torque = 0;
+        stats.stale++;
+    }
+    
+    memset(&command, 0, sizeof(command));
+    command.torque_command = (int16_t)((int32_t)torque * TORQUE_CMD_FULL_SCALE_DNM / TORQUE_MAX);
+    command.direction_command = TORQUE_CMD_DIRECTION;
+    command.inverter_enable = enabled;
+    inverter_command_pack(&msg, &command);
+    
+    // Sending the last frame late would only add age, or worse, carry an
+    // enable the FSM has since taken back. One already on the wire finishes
+    // and is counted by the ISR as usual, which must see its own stamp
+    if (CAN_isTXBufferPending(TORQUE_CMD_BUFFER)) {
+        CAN_abortTransmitBuffer(TORQUE_CMD_BUFFER);
+        stats.aborted++;
+        uint32_t abort_us = tick_get_us();
+        while (CAN_isTXBufferPending(TORQUE_CMD_BUFFER)) {
+            if (tick_get_us() - abort_us > TORQUE_CMD_ABORT_WAIT_US) {
+                // Aborted all the same, so nothing stale goes out later
+                return;
+            }
+        }
+    }
+    
+    // The ISR of the frame before must not see the new stamp
+    mask_tx_interrupt(true);
+    if (CAN_transmitBuffer(TORQUE_CMD_BUFFER, &msg)) {
+        frame_sample_us = sample_us;
+    }
+    mask_tx_interrupt(false);
+}
+
+void torque_cmd_get_stats(torque_cmd_stats_t* copy) {
+    mask_tx_interrupt(true);
+    *copy = stats;
+    mask_tx_interrupt(false);
+}
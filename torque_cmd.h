@@ -0,0 +1,63 @@
+#ifndef TORQUE_CMD_H
+#define TORQUE_CMD_H
+
+#include "mcc_generated_files/mcc.h"
+#include "can_messages.h"
+
+// Torque command stream to the motor controller
+// torque_cmd_send() runs every TORQUE_CMD_PERIOD_MS right after the sensor
+// and FSM tasks of the same tick, so each frame carries torque from pedal
+// values that have already passed the plausibility checks. It owns TXB0 at
+// the highest priority, so it never queues behind the telemetry frames in
+// can_tx. Every frame is stamped with the time its ADC scan completed; the
+// TXB0 interrupt, once the frame is on the wire, turns that into the
+// frame's end-to-end age.
+
+// Frames are the Cascadia Motion PM/RM command message, inverter_command_t
+// in can.dbc
+
+// Matches ADC_SCAN_PERIOD_US, so every new scan reaches the motor
+#define TORQUE_CMD_PERIOD_MS 2
+
+// Pedal-to-wire budget. Data older than this when the frame is built is
+// replaced with zero torque, and frames over it on the wire are counted
+#define TORQUE_CMD_BUDGET_US 4000
+
+// Longest a frame already on the wire can take to finish after an abort:
+// 8 data bytes at 500 kbps with worst-case bit stuffing
+#define TORQUE_CMD_ABORT_WAIT_US 300
+
+// TORQUE_MAX in the torque map is this many 0.1 Nm
+#define TORQUE_CMD_FULL_SCALE_DNM 1200
+
+// Forward for the way the motor is mounted
+#define TORQUE_CMD_DIRECTION 1
+
+// Age histogram in 1 ms bins; the last one is everything over budget
+#define TORQUE_CMD_AGE_BIN_US 1000
+#define TORQUE_CMD_AGE_BINS (TORQUE_CMD_BUDGET_US / TORQUE_CMD_AGE_BIN_US + 1)
+
+typedef struct {
+    uint16_t sent;              // frames acknowledged on the bus
+    uint16_t aborted;           // frames replaced by the next period's before they got on the bus
+    uint16_t stale;             // frames sent as zero torque because the data was too old
+    uint16_t over_budget;       // frames older than TORQUE_CMD_BUDGET_US on the wire
+    uint32_t age_max_us;
+    uint16_t age_bins[TORQUE_CMD_AGE_BINS];
+} torque_cmd_stats_t;
+
+void torque_cmd_init(void);
+
+// Builds and sends one command. torque is per mille of TORQUE_MAX and
+// sample_us the tick_get_us() time of the pedal values it came from. A
+// frame still waiting from the last period is aborted first, so a late
+// frame (which could still enable the inverter after DRIVE has ended) is
+// never sent; this waits at most TORQUE_CMD_ABORT_WAIT_US.
+// Outside DRIVE, pass enabled false; the stream keeps running with the
+// inverter disabled, which also clears its enable lockout
+void torque_cmd_send(uint16_t torque, bool enabled, uint32_t sample_us);
+
+// Copies the stats with the TXB0 interrupt held off
+void torque_cmd_get_stats(torque_cmd_stats_t* stats);
+
+#endif // TORQUE_CMD_H
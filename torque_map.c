@@ -0,0 +1,44 @@
+#include "torque_map.h"
+
+// Indexed by torque_map_mode_t; const keeps them in program memory
+static const uint16_t TORQUE_MAPS[TORQUE_MAP_COUNT][TORQUE_MAP_POINTS] = {
+    //  0%    10%   20%   30%   40%   50%   60%   70%   80%   90%   100%
+    {   0,    30,   80,   140,  210,  290,  380,  480,  590,  700,  800 },
+    {   0,    150,  300,  440,  570,  680,  780,  860,  930,  980,  1000 },
+    {   0,    10,   30,   60,   100,  150,  210,  280,  360,  450,  550 },
+};
+
+static torque_map_mode_t mode = TORQUE_MAP_ENDURANCE;
+
+void torque_map_select(torque_map_mode_t new_mode) {
+    if (new_mode < TORQUE_MAP_COUNT) {
+        mode = new_mode;
+    }
+}
+
+torque_map_mode_t torque_map_get_mode(void) {
+    return mode;
+}
+
+// x / 10 as a multiply and shift; exact for 0 <= x < 16384
+#define DIV10(x) ((uint16_t)(((uint32_t)(x) * 6554) >> 16))
+
+uint16_t torque_map_lookup(uint8_t percent) {
+    const uint16_t* map = TORQUE_MAPS[mode];
+    
+    if (percent >= 100) {
+        return map[TORQUE_MAP_POINTS - 1];
+    }
+    
+    uint8_t index = (uint8_t)DIV10(percent);
+    uint8_t offset = percent - index * TORQUE_MAP_STEP;
+    uint16_t low = map[index];
+    uint16_t high = map[index + 1];
+    
+    // |high - low| * offset is at most TORQUE_MAX * 9, inside DIV10's range
+    if (high >= low) {
+        return low + DIV10((high - low) * offset);
+    } else {
+        return low - DIV10((low - high) * offset);
+    }
+}
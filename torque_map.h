@@ -0,0 +1,32 @@
+#ifndef TORQUE_MAP_H
+#define TORQUE_MAP_H
+
+#include <stdint.h>
+
+// Throttle-to-torque maps
+// Each drive mode has a const table of torque at every TORQUE_MAP_STEP
+// percent of throttle, kept in program memory. Between points the torque is
+// linearly interpolated with multiplies and shifts only, so a lookup takes
+// the same few cycles whatever the map's shape.
+
+typedef enum {
+    TORQUE_MAP_ENDURANCE,       // soft and capped, for range
+    TORQUE_MAP_ACCELERATION,    // front-loaded, full torque
+    TORQUE_MAP_WET,             // gentle tip-in and a low cap for grip
+    TORQUE_MAP_COUNT
+} torque_map_mode_t;
+
+#define TORQUE_MAP_POINTS 11
+#define TORQUE_MAP_STEP 10
+
+// Torque is in per mille of the inverter's maximum
+#define TORQUE_MAX 1000
+
+// The mode used at reset is TORQUE_MAP_ENDURANCE
+void torque_map_select(torque_map_mode_t mode);
+torque_map_mode_t torque_map_get_mode(void);
+
+// Torque for a throttle percentage (0 to 100) under the selected map
+uint16_t torque_map_lookup(uint8_t percent);
+
+#endif // TORQUE_MAP_H
@@ -0,0 +1,46 @@
+#include "trace.h"
+#include "telemetry.h"
+
+static trace_entry_t ring[TRACE_SIZE];
+static uint8_t head = 0;        // next slot to write
+static uint8_t count = 0;       // entries held, up to TRACE_SIZE
+
+// Dump in progress. Entries recorded meanwhile are not part of it, but can
+// overwrite ones not sent yet if more than TRACE_SIZE arrive
+static uint8_t dump_next;
+static uint8_t dump_index = 0;
+static uint8_t dump_count = 0;
+
+trace_entry_t* trace_next(void) {
+    trace_entry_t* entry = &ring[head];
+    
+    head = (head + 1) & (TRACE_SIZE - 1);
+    if (count < TRACE_SIZE) {
+        count++;
+    }
+    return entry;
+}
+
+void trace_dump_start(void) {
+    dump_next = (head - count) & (TRACE_SIZE - 1);
+    dump_index = 0;
+    dump_count = count;
+}
+
+void trace_dump_run(void) {
+    trace_frame_t frame;
+    
+    // One entry per call, and only when the frame fits whole, so the dump
+    // does not crowd out the sample frames
+    if (dump_index == dump_count || !telemetry_can_send(sizeof(frame))) {
+        return;
+    }
+    
+    frame.index = dump_index;
+    frame.count = dump_count;
+    frame.entry = ring[dump_next];
+    telemetry_send(TELEMETRY_FRAME_TRACE, (const uint8_t*)&frame, sizeof(frame));
+    
+    dump_next = (dump_next + 1) & (TRACE_SIZE - 1);
+    dump_index++;
+}
@@ -0,0 +1,44 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+// Post-mortem trace of state transitions and faults
+// The last TRACE_SIZE transitions are kept in a RAM ring together with the
+// sensor values that triggered them, so a fault can still be reconstructed
+// after its telemetry has scrolled past. Recording is a few stores and
+// sends nothing; the console's "trace" command dumps the ring as
+// TELEMETRY_FRAME_TRACE frames, oldest first.
+
+// Power of two, so the index wraps with a mask
+#define TRACE_SIZE 32
+
+typedef struct {
+    uint32_t time_ms;
+    uint8_t from_state;
+    uint8_t from_error;
+    uint8_t to_state;
+    uint8_t to_error;
+    uint16_t throttle1;
+    uint16_t throttle2;
+    uint16_t brake;
+} trace_entry_t;
+
+// Payload of a TELEMETRY_FRAME_TRACE frame
+typedef struct {
+    uint8_t index;      // 0 is the oldest entry of this dump
+    uint8_t count;      // entries in this dump
+    trace_entry_t entry;
+} trace_frame_t;
+
+// Returns the slot for a new entry, overwriting the oldest once the ring
+// is full. The caller fills in every field
+trace_entry_t* trace_next(void);
+
+// Starts dumping the entries held now
+void trace_dump_start(void);
+
+// Call from a task; sends the next entry of a dump if the UART has room
+void trace_dump_run(void);
+
+#endif // TRACE_H